@@ -20,16 +20,11 @@
 namespace OHOS {
 RasterizerCellsAntiAlias::~RasterizerCellsAntiAlias()
 {
-    if (numBlocks_) {
-        CellBuildAntiAlias** ptr = cells_ + numBlocks_ - 1;
-        while (numBlocks_--) {
-            GeometryArrayAllocator<CellBuildAntiAlias>::Deallocate(*ptr, CELL_BLOCK_SIZE);
-            ptr--;
-        }
+    FreeBlocks(0);
+    if (cells_) {
         GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(cells_, maxBlocks_);
-        GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(sortedCells_, numCells_ + CELLS_SIZE);
-        GeometryArrayAllocator<SortedYLevel>::Deallocate(sortedY_, maxY_ - minY_ + 1 + CELLS_SIZE);
     }
+    FreeDenseBox();
 }
 
 /**
@@ -43,16 +38,27 @@ RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
       maxBlocks_(0),
       currBlock_(0),
       numCells_(0),
+      droppedCells_(0),
       cellBlockLimit_(cellBlockLimit),
       cells_(0),
       currCellPtr_(0),
-      sortedCells_(nullptr),
-      sortedY_(nullptr),
+      denseCover_(nullptr),
+      denseArea_(nullptr),
+      denseSize_(0),
+      denseWidth_(0),
+      denseHeight_(0),
+      denseMinX_(0),
+      denseMinY_(0),
       minX_(INT32_MAX),
       minY_(INT32_MAX),
       maxX_(INT32_MIN),
       maxY_(INT32_MIN),
-      sorted_(false)
+      minRow_(INT32_MIN),
+      maxRow_(INT32_MAX),
+      sorted_(false),
+      sortByValue_(false),
+      dense_(false),
+      denseSpilled_(false)
 {
     styleCell_.Initial();
     currCell_.Initial();
@@ -66,14 +72,70 @@ RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
 void RasterizerCellsAntiAlias::Reset()
 {
     numCells_ = 0;
+    droppedCells_ = 0;
     currBlock_ = 0;
     currCell_.Initial();
     styleCell_.Initial();
     sorted_ = false;
+    denseWidth_ = 0;
+    denseHeight_ = 0;
+    denseSpilled_ = false;
     minX_ = INT32_MAX;
     minY_ = INT32_MAX;
     maxX_ = INT32_MIN;
     maxY_ = INT32_MIN;
+    minRow_ = INT32_MIN;
+    maxRow_ = INT32_MAX;
+}
+
+/**
+ * @brief Release the sort buffers and the cell blocks that the current path does not use.
+ * The sorted cells of the current path are kept, so it can be called at any time.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::ShrinkToFit()
+{
+    FreeBlocks(currBlock_);
+    sortTemp_.Resize(0);
+    sortValueTemp_.Resize(0);
+    if (!sorted_) {
+        sortedCells_.Resize(0);
+        sortedValueCells_.Resize(0);
+        sortedY_.Resize(0);
+    }
+    if (denseWidth_ == 0) {
+        FreeDenseBox();
+    }
+}
+
+/**
+ * @brief Free the allocated cell blocks from index keepBlocks to the end.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::FreeBlocks(uint32_t keepBlocks)
+{
+    while (numBlocks_ > keepBlocks) {
+        --numBlocks_;
+        GeometryArrayAllocator<CellBuildAntiAlias>::Deallocate(cells_[numBlocks_], CELL_BLOCK_SIZE);
+        cells_[numBlocks_] = nullptr;
+    }
+}
+
+/**
+ * @brief Grow a sort buffer to hold at least size elements, keeping the capacity it already has.
+ * The buffer grows by half again to absorb paths that get slightly larger every frame.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class T>
+static inline T* ReserveSortBuffer(GeometryPlainDataArray<T>& buffer, uint32_t size)
+{
+    if (size > buffer.GetSize()) {
+        buffer.Resize(size + (size >> 1));
+    }
+    return buffer.Data();
 }
 
 /**
@@ -84,11 +146,17 @@ void RasterizerCellsAntiAlias::Reset()
 void RasterizerCellsAntiAlias::AddCurrentCell()
 {
     bool areaCoverFlags = currCell_.area | currCell_.cover;
-    if (areaCoverFlags) {
+    if (currCell_.y < minRow_ || currCell_.y > maxRow_) {
+        return;
+    }
+    if (areaCoverFlags && IsAccumulatingDense()) {
+        AddDenseCell();
+    } else if (areaCoverFlags) {
         // Reach CELL_BLOCK_MASK After the number of mask, re allocate memory
         if ((numCells_ & CELL_BLOCK_MASK) == 0) {
-            // Exceeds the memory block size limit. The default is 1024 limit
-            if (numBlocks_ >= cellBlockLimit_) {
+            // Exceeds the cell budget, the dropped cells tell the rasterizer to build the path in bands.
+            if (cellBlockLimit_ != 0 && currBlock_ >= cellBlockLimit_) {
+                ++droppedCells_;
                 return;
             }
             AllocateBlock();
@@ -98,6 +166,150 @@ void RasterizerCellsAntiAlias::AddCurrentCell()
     }
 }
 
+/**
+ * @brief Accumulate the current cell into the dense rows, the same cell may be added several times.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::AddDenseCell()
+{
+    uint32_t x = static_cast<uint32_t>(currCell_.x - denseMinX_);
+    uint32_t y = static_cast<uint32_t>(currCell_.y - denseMinY_);
+    if (x >= denseWidth_ || y >= denseHeight_) {
+        return;
+    }
+    uint32_t index = y * denseWidth_ + x;
+    denseCover_[index] += currCell_.cover;
+    denseArea_[index] += currCell_.area;
+    ++numCells_;
+}
+
+static inline uint64_t BoxPixels(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(x2) - x1 + 1) *
+        static_cast<uint64_t>(static_cast<int64_t>(y2) - y1 + 1);
+}
+
+/**
+ * @brief Grow the dense box to hold the pixels from (x1, y1) to (x2, y2) within the row range,
+ * keeping the accumulated rows.
+ * Exceeded sides grow by half of the box again, so a path added line by line rarely reallocates,
+ * or by nothing when that would exceed DENSE_BOX_LIMIT. A box exceeding it even so is spilled to the cell list.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::ExpandDenseBox(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    y1 = MATH_MAX(y1, minRow_);
+    y2 = MATH_MIN(y2, maxRow_);
+    if (y1 > y2) {
+        return;
+    }
+    int32_t right = denseMinX_ + static_cast<int32_t>(denseWidth_) - 1;
+    int32_t bottom = denseMinY_ + static_cast<int32_t>(denseHeight_) - 1;
+    if (denseWidth_ != 0) {
+        if (x1 >= denseMinX_ && y1 >= denseMinY_ && x2 <= right && y2 <= bottom) {
+            return;
+        }
+        x1 = MATH_MIN(x1, denseMinX_);
+        y1 = MATH_MIN(y1, denseMinY_);
+        x2 = MATH_MAX(x2, right);
+        y2 = MATH_MAX(y2, bottom);
+        int32_t marginX = static_cast<int32_t>(denseWidth_ >> 1);
+        int32_t marginY = static_cast<int32_t>(denseHeight_ >> 1);
+        int32_t grownX1 = (x1 < denseMinX_) ? x1 - marginX : x1;
+        int32_t grownY1 = (y1 < denseMinY_) ? MATH_MAX(y1 - marginY, minRow_) : y1;
+        int32_t grownX2 = (x2 > right) ? x2 + marginX : x2;
+        int32_t grownY2 = (y2 > bottom) ? MATH_MIN(y2 + marginY, maxRow_) : y2;
+        if (BoxPixels(grownX1, grownY1, grownX2, grownY2) <= DENSE_BOX_LIMIT) {
+            x1 = grownX1;
+            y1 = grownY1;
+            x2 = grownX2;
+            y2 = grownY2;
+        }
+    }
+    if (BoxPixels(x1, y1, x2, y2) > DENSE_BOX_LIMIT) {
+        SpillDenseBox();
+        return;
+    }
+    uint64_t width = static_cast<uint64_t>(static_cast<int64_t>(x2) - x1 + 1);
+    uint64_t height = static_cast<uint64_t>(static_cast<int64_t>(y2) - y1 + 1);
+    uint32_t size = static_cast<uint32_t>(width * height);
+    int32_t* cover = denseCover_;
+    int32_t* area = denseArea_;
+    // An empty box reuses the rows of a previous path, a growing box needs new rows to copy into
+    if (denseWidth_ != 0 || size > denseSize_) {
+        cover = GeometryArrayAllocator<int32_t>::Allocate(size);
+        area = GeometryArrayAllocator<int32_t>::Allocate(size);
+    }
+    if (memset_s(cover, sizeof(int32_t) * size, 0, sizeof(int32_t) * size) != EOK ||
+        memset_s(area, sizeof(int32_t) * size, 0, sizeof(int32_t) * size) != EOK) {
+        GRAPHIC_LOGE("RasterizerCellsAntiAlias::ExpandDenseBox memset_s fail");
+    }
+    for (uint32_t row = 0; row < denseHeight_; row++) {
+        uint32_t index = static_cast<uint32_t>(denseMinY_ - y1 + static_cast<int32_t>(row)) *
+            static_cast<uint32_t>(width) + static_cast<uint32_t>(denseMinX_ - x1);
+        if (memcpy_s(cover + index, sizeof(int32_t) * (size - index), denseCover_ + row * denseWidth_,
+                     sizeof(int32_t) * denseWidth_) != EOK ||
+            memcpy_s(area + index, sizeof(int32_t) * (size - index), denseArea_ + row * denseWidth_,
+                     sizeof(int32_t) * denseWidth_) != EOK) {
+            GRAPHIC_LOGE("RasterizerCellsAntiAlias::ExpandDenseBox memcpy_s fail");
+        }
+    }
+    if (cover != denseCover_) {
+        FreeDenseBox();
+        denseCover_ = cover;
+        denseArea_ = area;
+        denseSize_ = size;
+    }
+    denseWidth_ = static_cast<uint32_t>(width);
+    denseHeight_ = static_cast<uint32_t>(height);
+    denseMinX_ = x1;
+    denseMinY_ = y1;
+}
+
+/**
+ * @brief Move the accumulated cells of the dense box to the cell list, which takes the rest of the path.
+ * The cells then count against the cell budget, so a path too large for both is built band by band.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::SpillDenseBox()
+{
+    denseSpilled_ = true;
+    // The current cell is not accumulated yet, it is added to the list when the line leaves it
+    CellBuildAntiAlias pendingCell = currCell_;
+    numCells_ = 0;
+    for (uint32_t row = 0; row < denseHeight_; row++) {
+        const int32_t* cover = denseCover_ + row * denseWidth_;
+        const int32_t* area = denseArea_ + row * denseWidth_;
+        for (uint32_t col = 0; col < denseWidth_; col++) {
+            if ((cover[col] | area[col]) == 0) {
+                continue;
+            }
+            currCell_.x = denseMinX_ + static_cast<int32_t>(col);
+            currCell_.y = denseMinY_ + static_cast<int32_t>(row);
+            currCell_.cover = cover[col];
+            currCell_.area = area[col];
+            AddCurrentCell();
+        }
+    }
+    currCell_ = pendingCell;
+    denseWidth_ = 0;
+    denseHeight_ = 0;
+}
+
+void RasterizerCellsAntiAlias::FreeDenseBox()
+{
+    if (denseCover_ != nullptr) {
+        GeometryArrayAllocator<int32_t>::Deallocate(denseCover_, denseSize_);
+        GeometryArrayAllocator<int32_t>::Deallocate(denseArea_, denseSize_);
+    }
+    denseCover_ = nullptr;
+    denseArea_ = nullptr;
+    denseSize_ = 0;
+}
+
 /**
  * @brief Set the current cell during rasterization.
  * @since 1.0
@@ -118,32 +330,16 @@ inline void RasterizerCellsAntiAlias::SetCurrentCell(int32_t x, int32_t y)
 void RasterizerCellsAntiAlias::OutLineLegal(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
     /**
-     * outline range
+     * outline range, the extent of the line first, so that each bound takes one select instead of two branches
      */
-    if (x1 < minX_) {
-        minX_ = x1;
-    }
-    if (x1 > maxX_) {
-        maxX_ = x1;
-    }
-    if (y1 < minY_) {
-        minY_ = y1;
-    }
-    if (y1 > maxY_) {
-        maxY_ = y1;
-    }
-    if (x2 < minX_) {
-        minX_ = x2;
-    }
-    if (x2 > maxX_) {
-        maxX_ = x2;
-    }
-    if (y2 < minY_) {
-        minY_ = y2;
-    }
-    if (y2 > maxY_) {
-        maxY_ = y2;
-    }
+    int32_t lineMinX = MATH_MIN(x1, x2);
+    int32_t lineMaxX = MATH_MAX(x1, x2);
+    int32_t lineMinY = MATH_MIN(y1, y2);
+    int32_t lineMaxY = MATH_MAX(y1, y2);
+    minX_ = MATH_MIN(minX_, lineMinX);
+    maxX_ = MATH_MAX(maxX_, lineMaxX);
+    minY_ = MATH_MIN(minY_, lineMinY);
+    maxY_ = MATH_MAX(maxY_, lineMaxY);
 }
 
 /**
@@ -283,7 +479,13 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     int32_t modDyMask, delta, first, increase;
     int64_t deltaxMask;
 
+    if (MATH_MAX(ey1, ey2) < minRow_ || MATH_MIN(ey1, ey2) > maxRow_) {
+        return;
+    }
     OutLineLegal(ex1, ey1, ex2, ey2);
+    if (IsAccumulatingDense()) {
+        ExpandDenseBox(MATH_MIN(ex1, ex2), MATH_MIN(ey1, ey2), MATH_MAX(ex1, ex2), MATH_MAX(ey1, ey2));
+    }
     SetCurrentCell(ex1, ey1);
 
     /**
@@ -320,13 +522,14 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     modDyMask = static_cast<int32_t>(deltaxMask % dy);
     if (modDyMask < 0) {
         delta--;
+        modDyMask += dy;
     }
     xFrom = x1 + delta;
     RenderHorizonline(ey1, x1, submaskFlagsY1, xFrom, first);
     ey1 += increase;
     SetCurrentCell(xFrom >> POLY_SUBPIXEL_SHIFT, ey1);
     if (ey1 != ey2) {
-        RenderObliqueLine(dx, dy, first, increase, xFrom, deltaxMask, ey1, ey2, delta);
+        RenderObliqueLine(dx, dy, first, increase, xFrom, deltaxMask, ey1, ey2, delta, modDyMask);
     }
     RenderHorizonline(ey1, xFrom, POLY_SUBPIXEL_SCALE - first, x2, submaskFlagsY2);
 }
@@ -373,7 +576,7 @@ void RasterizerCellsAntiAlias::RenderVerticalLine(int32_t& x1, int32_t& ex1, int
 
 void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32_t& first,
                                                  int32_t& increase, int32_t& xFrom, int64_t& deltaxMask,
-                                                 int32_t& ey1, int32_t& ey2, int32_t& delta)
+                                                 int32_t& ey1, int32_t& ey2, int32_t& delta, int32_t modDyMask)
 {
     int32_t remDyMask, liftDyMask;
     deltaxMask = POLY_SUBPIXEL_SCALE * dx;
@@ -383,7 +586,8 @@ void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32
         liftDyMask--;
         remDyMask += dy;
     }
-    int32_t modDyMask = -dy;
+    // Continue from the remainder of the first step, so that the last cell ends at x2
+    modDyMask -= dy;
     while (ey1 != ey2) {
         delta = liftDyMask;
         modDyMask += remDyMask;
@@ -447,14 +651,24 @@ void RasterizerCellsAntiAlias::SortAllCells()
     if (numCells_ == 0) {
         return;
     }
+    // Lines crossing the row range extended the bounds beyond the rows that have cells
+    minY_ = MATH_MAX(minY_, minRow_);
+    maxY_ = MATH_MIN(maxY_, maxRow_);
+    if (IsAccumulatingDense()) {
+        // The cells are accumulated in place, there is nothing to sort.
+        // The box holds every cell, so the bounds are limited to it.
+        minX_ = MATH_MAX(minX_, denseMinX_);
+        minY_ = MATH_MAX(minY_, denseMinY_);
+        maxX_ = MATH_MIN(maxX_, denseMinX_ + static_cast<int32_t>(denseWidth_) - 1);
+        maxY_ = MATH_MIN(maxY_, denseMinY_ + static_cast<int32_t>(denseHeight_) - 1);
+        sorted_ = true;
+        return;
+    }
 
-    // Allocate the array of cell pointers
-    sortedCells_ = GeometryArrayAllocator<CellBuildAntiAlias*>::Allocate(numCells_ + CELLS_SIZE);
-
-    // Allocate and zero the Y array
+    // Reserve and zero the Y array
     uint32_t sortedYSize = maxY_ - minY_ + 1;
-    sortedY_ = GeometryArrayAllocator<SortedYLevel>::Allocate(sortedYSize + CELLS_SIZE);
-    if (memset_s(sortedY_, sizeof(SortedYLevel) * sortedYSize, 0, sizeof(SortedYLevel) * sortedYSize) != EOK) {
+    SortedYLevel* sortedY = ReserveSortBuffer(sortedY_, sortedYSize + CELLS_SIZE);
+    if (memset_s(sortedY, sizeof(SortedYLevel) * sortedYSize, 0, sizeof(SortedYLevel) * sortedYSize) != EOK) {
         GRAPHIC_LOGE("CleanData fail");
     }
 
@@ -475,35 +689,198 @@ void RasterizerCellsAntiAlias::SortAllCells()
 
     // Convert the Y-histogram into the array of starting indexes
     uint32_t start = 0;
+    uint32_t maxRowCells = 0;
     for (i = 0; i < sortedYSize; i++) {
         uint32_t v = sortedY_[i].start;
         sortedY_[i].start = start;
         start += v;
+        if (v > maxRowCells) {
+            maxRowCells = v;
+        }
     }
 
+    if (sortByValue_) {
+        SortCellsByValue(maxRowCells);
+    } else {
+        SortCellsByPointer(maxRowCells);
+    }
+    sorted_ = true;
+}
+
+/**
+ * @brief Fill the cell pointer array sorted by Y, then arrange the X-arrays.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::SortCellsByPointer(uint32_t maxRowCells)
+{
+    // Reserve the array of cell pointers
+    CellBuildAntiAlias** sortedCells = ReserveSortBuffer(sortedCells_, numCells_ + CELLS_SIZE);
+
     // Fill the cell pointer array sorted by Y
-    blockPtr = cells_;
-    nb = numCells_;
+    CellBuildAntiAlias** blockPtr = cells_;
+    CellBuildAntiAlias* cellPtr = nullptr;
+    uint32_t nb = numCells_;
+    uint32_t i = 0;
     while (nb) {
         cellPtr = *blockPtr++;
         i = (nb > CELL_BLOCK_SIZE) ? uint32_t(CELL_BLOCK_SIZE) : nb;
         nb -= i;
         while (i--) {
             SortedYLevel& currY = sortedY_[cellPtr->y - minY_];
-            sortedCells_[currY.start + currY.num] = cellPtr;
+            sortedCells[currY.start + currY.num] = cellPtr;
             ++currY.num;
             ++cellPtr;
         }
     }
 
+    // Rows with many cells are sorted by radix, which needs a scratch array
+    CellBuildAntiAlias** sortTemp = nullptr;
+    if (maxRowCells >= RADIX_SORT_THRESHOLD) {
+        sortTemp = ReserveSortBuffer(sortTemp_, maxRowCells);
+    }
+
     // Finally arrange the X-arrays
+    uint32_t sortedYSize = maxY_ - minY_ + 1;
     for (i = 0; i < sortedYSize; i++) {
         const SortedYLevel& currY = sortedY_[i];
-        if (currY.num) {
-            QsortCells(sortedCells_ + currY.start, currY.num);
+        if (currY.num >= RADIX_SORT_THRESHOLD && sortTemp != nullptr) {
+            RadixSortCells(sortedCells + currY.start, currY.num, sortTemp);
+        } else if (currY.num) {
+            QsortCells(sortedCells + currY.start, currY.num);
         }
     }
-    sorted_ = true;
+}
+
+/**
+ * @brief Copy the cells themselves into a contiguous array sorted by Y, then arrange the X-arrays,
+ * so that every scanline is read as one linear stream.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::SortCellsByValue(uint32_t maxRowCells)
+{
+    CellBuildAntiAlias* sortedValueCells = ReserveSortBuffer(sortedValueCells_, numCells_ + CELLS_SIZE);
+
+    // Scatter the cells sorted by Y
+    CellBuildAntiAlias** blockPtr = cells_;
+    CellBuildAntiAlias* cellPtr = nullptr;
+    uint32_t nb = numCells_;
+    uint32_t i = 0;
+    while (nb) {
+        cellPtr = *blockPtr++;
+        i = (nb > CELL_BLOCK_SIZE) ? uint32_t(CELL_BLOCK_SIZE) : nb;
+        nb -= i;
+        while (i--) {
+            SortedYLevel& currY = sortedY_[cellPtr->y - minY_];
+            sortedValueCells[currY.start + currY.num] = *cellPtr;
+            ++currY.num;
+            ++cellPtr;
+        }
+    }
+
+    CellBuildAntiAlias* sortTemp = nullptr;
+    if (maxRowCells >= RADIX_SORT_THRESHOLD) {
+        sortTemp = ReserveSortBuffer(sortValueTemp_, maxRowCells);
+    }
+
+    // Finally arrange the X-arrays
+    uint32_t sortedYSize = maxY_ - minY_ + 1;
+    for (i = 0; i < sortedYSize; i++) {
+        const SortedYLevel& currY = sortedY_[i];
+        if (currY.num >= RADIX_SORT_THRESHOLD && sortTemp != nullptr) {
+            RadixSortCells(sortedValueCells + currY.start, currY.num, sortTemp);
+        } else if (currY.num) {
+            InsertSortCells(sortedValueCells + currY.start, currY.num);
+        }
+    }
+}
+
+static inline int32_t GetSortCellX(const CellBuildAntiAlias* cell)
+{
+    return cell->x;
+}
+
+static inline int32_t GetSortCellX(const CellBuildAntiAlias& cell)
+{
+    return cell.x;
+}
+
+template <class T>
+void RadixSortCells(T* start, uint32_t num, T* temp)
+{
+    const uint32_t radixShift = 8;
+    const uint32_t radixSize = 1 << radixShift;
+    const uint32_t radixMask = radixSize - 1;
+    const uint32_t keyBits = 32;
+    uint32_t count[radixSize];
+
+    /**
+     * The key is the offset from the leftmost cell of the row,
+     * so the number of passes only depends on the width of the row.
+     */
+    int32_t rowMinX = GetSortCellX(start[0]);
+    int32_t rowMaxX = rowMinX;
+    for (uint32_t i = 1; i < num; i++) {
+        int32_t x = GetSortCellX(start[i]);
+        if (x < rowMinX) {
+            rowMinX = x;
+        }
+        if (x > rowMaxX) {
+            rowMaxX = x;
+        }
+    }
+    uint32_t span = static_cast<uint32_t>(rowMaxX) - static_cast<uint32_t>(rowMinX);
+
+    T* src = start;
+    T* dst = temp;
+    for (uint32_t shift = 0; shift < keyBits && (span >> shift) != 0; shift += radixShift) {
+        if (memset_s(count, sizeof(count), 0, sizeof(count)) != EOK) {
+            GRAPHIC_LOGE("RadixSortCells memset_s fail");
+            return;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            count[((static_cast<uint32_t>(GetSortCellX(src[i])) - static_cast<uint32_t>(rowMinX)) >> shift) &
+                  radixMask]++;
+        }
+        // Convert the histogram into the array of starting indexes
+        uint32_t pos = 0;
+        for (uint32_t j = 0; j < radixSize; j++) {
+            uint32_t v = count[j];
+            count[j] = pos;
+            pos += v;
+        }
+        // Stable scatter, cells with the same digit keep the order of the previous pass
+        for (uint32_t i = 0; i < num; i++) {
+            uint32_t key = ((static_cast<uint32_t>(GetSortCellX(src[i])) - static_cast<uint32_t>(rowMinX)) >> shift) &
+                radixMask;
+            dst[count[key]++] = src[i];
+        }
+        T* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != start) {
+        if (memcpy_s(start, num * sizeof(T), src, num * sizeof(T)) != EOK) {
+            GRAPHIC_LOGE("RadixSortCells memcpy_s fail");
+        }
+    }
+}
+
+template void RadixSortCells(CellBuildAntiAlias** start, uint32_t num, CellBuildAntiAlias** temp);
+template void RadixSortCells(CellBuildAntiAlias* start, uint32_t num, CellBuildAntiAlias* temp);
+
+void InsertSortCells(CellBuildAntiAlias* start, uint32_t num)
+{
+    for (uint32_t i = 1; i < num; i++) {
+        CellBuildAntiAlias cell = start[i];
+        uint32_t j = i;
+        while (j > 0 && cell.x < start[j - 1].x) {
+            start[j] = start[j - 1];
+            j--;
+        }
+        start[j] = cell;
+    }
 }
 
 void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex)
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_clip_region.h"
+
+namespace OHOS {
+/**
+ * @brief Collect the x intervals of the rectangles covering the rows from top to bottom,
+ * sorted by x and with the overlapping or touching ones merged.
+ * @return The number of intervals, at most the number of rectangles.
+ * @since 1.0
+ * @version 1.0
+ */
+uint32_t RasterizerClipRegion::CollectIntervals(const Rect32* rects, uint32_t numRects, int32_t top, int32_t bottom,
+                                                ClipInterval* intervals) const
+{
+    uint32_t numIntervals = 0;
+    for (uint32_t i = 0; i < numRects; i++) {
+        const Rect32& rect = rects[i];
+        if (rect.GetLeft() > rect.GetRight() || rect.GetTop() > top || rect.GetBottom() < bottom) {
+            continue;
+        }
+        // Insertion sort, there are only a few dirty rectangles
+        uint32_t k = numIntervals++;
+        while (k > 0 && intervals[k - 1].left > rect.GetLeft()) {
+            intervals[k] = intervals[k - 1];
+            k--;
+        }
+        intervals[k].left = rect.GetLeft();
+        intervals[k].right = rect.GetRight();
+    }
+    if (numIntervals == 0) {
+        return 0;
+    }
+    uint32_t last = 0;
+    for (uint32_t i = 1; i < numIntervals; i++) {
+        if (intervals[i].left <= intervals[last].right + 1) {
+            intervals[last].right = MATH_MAX(intervals[last].right, intervals[i].right);
+        } else {
+            intervals[++last] = intervals[i];
+        }
+    }
+    return last + 1;
+}
+
+void RasterizerClipRegion::SetRects(const Rect32* rects, uint32_t numRects)
+{
+    Reset();
+    if (rects == nullptr || numRects == 0) {
+        return;
+    }
+    // The rows where the set of rectangles changes, the bands lie between them
+    uint32_t numEdges = 0;
+    if (edges_.GetSize() < numRects * 2) {
+        edges_.Resize(numRects * 2);
+    }
+    int32_t* edges = edges_.Data();
+    for (uint32_t i = 0; i < numRects; i++) {
+        if (rects[i].GetLeft() > rects[i].GetRight() || rects[i].GetTop() > rects[i].GetBottom()) {
+            continue;
+        }
+        int32_t rowEdges[] = {rects[i].GetTop(), rects[i].GetBottom() + 1};
+        for (int32_t edge : rowEdges) {
+            uint32_t k = numEdges;
+            while (k > 0 && edges[k - 1] > edge) {
+                k--;
+            }
+            if (k > 0 && edges[k - 1] == edge) {
+                continue;
+            }
+            for (uint32_t j = numEdges; j > k; j--) {
+                edges[j] = edges[j - 1];
+            }
+            edges[k] = edge;
+            numEdges++;
+        }
+    }
+    if (numEdges < 2) {
+        return;
+    }
+    // Every band has at most one interval per rectangle
+    uint32_t maxIntervals = (numEdges - 1) * numRects;
+    if (bands_.GetSize() < numEdges - 1) {
+        bands_.Resize(numEdges - 1);
+    }
+    if (intervals_.GetSize() < maxIntervals) {
+        intervals_.Resize(maxIntervals);
+    }
+    ClipBand* bands = bands_.Data();
+    ClipInterval* intervals = intervals_.Data();
+    uint32_t numIntervals = 0;
+    for (uint32_t i = 0; i + 1 < numEdges; i++) {
+        int32_t top = edges[i];
+        int32_t bottom = edges[i + 1] - 1;
+        uint32_t count = CollectIntervals(rects, numRects, top, bottom, intervals + numIntervals);
+        if (count == 0) {
+            continue;
+        }
+        if (numBands_ > 0) {
+            // Join the band to the previous one when it is adjacent and has the same intervals
+            ClipBand& prev = bands[numBands_ - 1];
+            bool same = (prev.bottom + 1 == top) && (prev.numIntervals == count);
+            for (uint32_t k = 0; same && k < count; k++) {
+                same = intervals[prev.firstInterval + k].left == intervals[numIntervals + k].left &&
+                       intervals[prev.firstInterval + k].right == intervals[numIntervals + k].right;
+            }
+            if (same) {
+                prev.bottom = bottom;
+                continue;
+            }
+        }
+        ClipBand& band = bands[numBands_++];
+        band.top = top;
+        band.bottom = bottom;
+        band.firstInterval = numIntervals;
+        band.numIntervals = count;
+        numIntervals += count;
+    }
+    if (numBands_ == 0) {
+        return;
+    }
+    minY_ = bands[0].top;
+    maxY_ = bands[numBands_ - 1].bottom;
+    minX_ = intervals[0].left;
+    maxX_ = intervals[0].right;
+    for (uint32_t i = 0; i < numBands_; i++) {
+        minX_ = MATH_MIN(minX_, intervals[bands[i].firstInterval].left);
+        maxX_ = MATH_MAX(maxX_, intervals[bands[i].firstInterval + bands[i].numIntervals - 1].right);
+    }
+}
+
+/**
+ * @brief The band holding the row y, the rows being visited from top to bottom.
+ * @since 1.0
+ * @version 1.0
+ */
+const RasterizerClipRegion::ClipBand* RasterizerClipRegion::FindBand(int32_t y)
+{
+    if (numBands_ == 0) {
+        return nullptr;
+    }
+    const ClipBand* bands = bands_.Data();
+    if (curBand_ >= numBands_ || y < bands[curBand_].top) {
+        curBand_ = 0;
+    }
+    while (curBand_ < numBands_ && bands[curBand_].bottom < y) {
+        curBand_++;
+    }
+    if (curBand_ >= numBands_ || y < bands[curBand_].top) {
+        return nullptr;
+    }
+    return bands + curBand_;
+}
+
+bool RasterizerClipRegion::Contains(int32_t x, int32_t y)
+{
+    const ClipBand* band = FindBand(y);
+    if (band == nullptr) {
+        return false;
+    }
+    const ClipInterval* intervals = intervals_.Data() + band->firstInterval;
+    for (uint32_t i = 0; i < band->numIntervals; i++) {
+        if (x < intervals[i].left) {
+            return false;
+        }
+        if (x <= intervals[i].right) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace OHOS
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_hit_test.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+
+namespace OHOS {
+RasterizerHitTest::RasterizerHitTest()
+    : edges_(nullptr),
+      numEdges_(0),
+      maxEdges_(0),
+      numRows_(0),
+      rowScale_(0),
+      startX_(0),
+      startY_(0),
+      lastX_(0),
+      lastY_(0),
+      minX_(0),
+      minY_(0),
+      maxX_(0),
+      maxY_(0),
+      fillingRule_(FILL_NON_ZERO),
+      open_(false),
+      indexed_(false) {}
+
+RasterizerHitTest::~RasterizerHitTest()
+{
+    if (edges_ != nullptr) {
+        GeometryArrayAllocator<HitEdge>::Deallocate(edges_, maxEdges_);
+    }
+}
+
+void RasterizerHitTest::Reset()
+{
+    numEdges_ = 0;
+    numRows_ = 0;
+    open_ = false;
+    indexed_ = false;
+}
+
+/**
+ * @brief Keep an edge that is not horizontal, oriented from its top to its bottom.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerHitTest::AddEdge(float x1, float y1, float x2, float y2)
+{
+    if (y1 == y2) {
+        return;
+    }
+    if (numEdges_ >= maxEdges_) {
+        uint32_t newMaxEdges = maxEdges_ + EDGE_BLOCK_POOL + (maxEdges_ >> 1);
+        HitEdge* newEdges = GeometryArrayAllocator<HitEdge>::Allocate(newMaxEdges);
+        if (newEdges == nullptr) {
+            GRAPHIC_LOGE("RasterizerHitTest::AddEdge allocate fail\n");
+            return;
+        }
+        if (edges_ != nullptr) {
+            if (memcpy_s(newEdges, newMaxEdges * sizeof(HitEdge), edges_, numEdges_ * sizeof(HitEdge)) != EOK) {
+                GRAPHIC_LOGE("RasterizerHitTest::AddEdge memcpy_s fail\n");
+            }
+            GeometryArrayAllocator<HitEdge>::Deallocate(edges_, maxEdges_);
+        }
+        edges_ = newEdges;
+        maxEdges_ = newMaxEdges;
+    }
+    HitEdge& edge = edges_[numEdges_];
+    if (y1 < y2) {
+        edge.x = x1;
+        edge.top = y1;
+        edge.bottom = y2;
+        edge.dir = 1;
+    } else {
+        edge.x = x2;
+        edge.top = y2;
+        edge.bottom = y1;
+        edge.dir = -1;
+    }
+    edge.slope = (x2 - x1) / (y2 - y1);
+
+    if (numEdges_ == 0) {
+        minX_ = MATH_MIN(x1, x2);
+        maxX_ = MATH_MAX(x1, x2);
+        minY_ = edge.top;
+        maxY_ = edge.bottom;
+    } else {
+        minX_ = MATH_MIN(minX_, MATH_MIN(x1, x2));
+        maxX_ = MATH_MAX(maxX_, MATH_MAX(x1, x2));
+        minY_ = MATH_MIN(minY_, edge.top);
+        maxY_ = MATH_MAX(maxY_, edge.bottom);
+    }
+    ++numEdges_;
+    indexed_ = false;
+}
+
+void RasterizerHitTest::MoveTo(float x, float y)
+{
+    ClosePolygon();
+    startX_ = x;
+    startY_ = y;
+    lastX_ = x;
+    lastY_ = y;
+    open_ = true;
+}
+
+void RasterizerHitTest::LineTo(float x, float y)
+{
+    if (!open_) {
+        MoveTo(lastX_, lastY_);
+    }
+    AddEdge(lastX_, lastY_, x, y);
+    lastX_ = x;
+    lastY_ = y;
+}
+
+void RasterizerHitTest::ClosePolygon()
+{
+    if (open_) {
+        AddEdge(lastX_, lastY_, startX_, startY_);
+        lastX_ = startX_;
+        lastY_ = startY_;
+        open_ = false;
+    }
+}
+
+void RasterizerHitTest::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveTo(x, y);
+    } else if (IsVertex(cmd)) {
+        LineTo(x, y);
+    } else if (IsClose(cmd)) {
+        ClosePolygon();
+    }
+}
+
+uint32_t RasterizerHitTest::GetRow(float y) const
+{
+    float row = (y - minY_) * rowScale_;
+    if (row <= 0) {
+        return 0;
+    }
+    if (row >= static_cast<float>(numRows_ - 1)) {
+        return numRows_ - 1;
+    }
+    return static_cast<uint32_t>(row);
+}
+
+/**
+ * @brief List the edges crossing each row, an edge is listed in every row from its top to its bottom.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerHitTest::IndexRows()
+{
+    numRows_ = MATH_MIN(numEdges_, static_cast<uint32_t>(HIT_MAX_ROWS));
+    rowScale_ = static_cast<float>(numRows_) / (maxY_ - minY_);
+    if (rowStart_.GetSize() < numRows_ + 1) {
+        rowStart_.Resize(numRows_ + 1);
+    }
+    uint32_t* rowStart = rowStart_.Data();
+    if (memset_s(rowStart, rowStart_.GetSize() * sizeof(uint32_t), 0, (numRows_ + 1) * sizeof(uint32_t)) != EOK) {
+        GRAPHIC_LOGE("RasterizerHitTest::IndexRows memset_s fail\n");
+    }
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < numEdges_; i++) {
+        uint32_t lastRow = GetRow(edges_[i].bottom);
+        for (uint32_t row = GetRow(edges_[i].top); row <= lastRow; row++) {
+            ++rowStart[row + 1];
+        }
+        total += lastRow - GetRow(edges_[i].top) + 1;
+    }
+    for (uint32_t row = 0; row < numRows_; row++) {
+        rowStart[row + 1] += rowStart[row];
+    }
+    if (rowEdges_.GetSize() < total) {
+        rowEdges_.Resize(total);
+    }
+    uint32_t* rowEdges = rowEdges_.Data();
+    for (uint32_t i = 0; i < numEdges_; i++) {
+        uint32_t lastRow = GetRow(edges_[i].bottom);
+        for (uint32_t row = GetRow(edges_[i].top); row <= lastRow; row++) {
+            rowEdges[rowStart[row]++] = i;
+        }
+    }
+    // Filling moved every start to the end of its row, which is the start of the next one
+    for (uint32_t row = numRows_; row > 0; row--) {
+        rowStart[row] = rowStart[row - 1];
+    }
+    rowStart[0] = 0;
+    indexed_ = true;
+}
+
+/**
+ * @brief Count the edges crossing the ray from the point to the right, an edge covers the rows
+ * from its top up to but excluding its bottom, so a shared vertex is counted once.
+ * @since 1.0
+ * @version 1.0
+ */
+int32_t RasterizerHitTest::GetWindingNumber(float x, float y)
+{
+    ClosePolygon();
+    if (numEdges_ == 0 || y < minY_ || y >= maxY_ || x < minX_ || x >= maxX_) {
+        return 0;
+    }
+    if (!indexed_) {
+        IndexRows();
+    }
+    uint32_t row = GetRow(y);
+    const uint32_t* rowEdges = rowEdges_.Data();
+    int32_t winding = 0;
+    for (uint32_t i = rowStart_[row]; i < rowStart_[row + 1]; i++) {
+        const HitEdge& edge = edges_[rowEdges[i]];
+        if (y >= edge.top && y < edge.bottom && edge.x + (y - edge.top) * edge.slope > x) {
+            winding += edge.dir;
+        }
+    }
+    return winding;
+}
+} // namespace OHOS
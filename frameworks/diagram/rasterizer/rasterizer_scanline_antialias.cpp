@@ -14,6 +14,7 @@
  */
 
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "graphic_neon_utils.h"
 
 namespace OHOS {
 /**
@@ -26,62 +27,300 @@ namespace OHOS {
  * @since 1.0
  * @version 1.0
  */
-bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline& sl)
+template <class Scanline>
+bool RasterizerScanlineAntialias::SweepScanline(Scanline& sl)
 {
     while (true) {
-        if (scanY_ > outline_.GetMaxY()) {
+        if (scanY_ > outline_.GetMaxY() && !(banded_ && RasterizeNextBand())) {
             return false;
         }
-        sl.ResetSpans();
-        uint32_t numCells = outline_.GetScanlineNumCells(scanY_);
-        const CellBuildAntiAlias * const *cells = outline_.GetScanlineCells(scanY_);
-        int32_t cover = 0;
+        if (!SweepRow(sl, scanY_)) {
+            GRAPHIC_LOGE("Text: RasterizerScanlineAntialias::SweepScanline can not new curCell");
+            return true;
+        }
+
+        if (sl.NumSpans()) {
+            break;
+        }
+        ++scanY_;
+    }
 
-        while (numCells) {
-            const CellBuildAntiAlias* curCell = *cells;
-            if (curCell == nullptr) {
-                GRAPHIC_LOGE("Text: RasterizerScanlineAntialias::SweepScanline can not new curCell");
-                return true;
+    sl.Finalize(scanY_);
+    ++scanY_;
+    return true;
+}
+
+static inline const CellBuildAntiAlias* GetSweepCell(const CellBuildAntiAlias* const* cells)
+{
+    return *cells;
+}
+
+static inline const CellBuildAntiAlias* GetSweepCell(const CellBuildAntiAlias* cells)
+{
+    return cells;
+}
+
+/**
+ * @brief Iterate the x-sorted cells of one scanline, either through the pointer array
+ * or directly over the cells sorted by value, and add the cells and spans to the scanline.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline, class CellIterator>
+bool RasterizerScanlineAntialias::SweepCells(Scanline& sl, CellIterator cells, uint32_t numCells)
+{
+    if (numCells >= DENSE_ROW_MIN_CELLS) {
+        const CellBuildAntiAlias* firstCell = GetSweepCell(cells);
+        const CellBuildAntiAlias* lastCell = GetSweepCell(cells + (numCells - 1));
+        if (firstCell != nullptr && lastCell != nullptr) {
+            uint32_t width = static_cast<uint32_t>(lastCell->x - firstCell->x) + 1;
+            if (width <= numCells * DENSE_ROW_RATIO) {
+                return SweepDenseCells(sl, cells, numCells, firstCell->x, width);
             }
-            int32_t x = curCell->x;
-            int32_t area = curCell->area;
-            uint32_t alpha;
+        }
+    }
+    int32_t cover = 0;
+    while (numCells) {
+        const CellBuildAntiAlias* curCell = GetSweepCell(cells);
+        if (curCell == nullptr) {
+            return false;
+        }
+        int32_t x = curCell->x;
+        int32_t area = curCell->area;
+        uint32_t alpha;
 
+        cover += curCell->cover;
+        // accumulate all cells with the same X
+        while (--numCells && (curCell = GetSweepCell(++cells)) && (curCell != nullptr) && (curCell->x == x)) {
+            area += curCell->area;
             cover += curCell->cover;
-            // accumulate all cells with the same X
-            while (--numCells && (curCell = *++cells) && (curCell != nullptr) && (curCell->x == x)) {
-                area += curCell->area;
-                cover += curCell->cover;
+        }
+        if (area) {
+            // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
+            // Cover can be understood as a delta mask with an area of 1
+            alpha = CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
+            if (alpha) {
+                sl.AddCell(x, alpha);
             }
-            if (area) {
-                // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
-                // Cover can be understood as a delta mask with an area of 1
-                alpha = CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
-                if (alpha) {
-                    sl.AddCell(x, alpha);
-                }
-                x++;
+            x++;
+        }
+        if (numCells && (curCell != nullptr) && curCell->x > x) {
+            // At this time, area is 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
+            alpha = CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
+            if (alpha) {
+                sl.AddSpan(x, curCell->x - x, alpha);
+            }
+        }
+    }
+    return true;
+}
+
+#ifdef ARM_NEON_OPT
+/**
+ * @brief Inclusive prefix sum of the four lanes, plus the carry of the previous lanes.
+ * @since 1.0
+ * @version 1.0
+ */
+static inline int32x4_t NeonPrefixSum(int32x4_t value, int32x4_t carry)
+{
+    int32x4_t zero = vdupq_n_s32(0);
+    value = vaddq_s32(value, vextq_s32(zero, value, 3)); // 3: shift the lanes up by one
+    value = vaddq_s32(value, vextq_s32(zero, value, 2)); // 2: shift the lanes up by two
+    return vaddq_s32(value, carry);
+}
+
+/**
+ * @brief Convert four accumulated covers and areas to 16-bit coverage, the same way as CalculateAlpha.
+ * @since 1.0
+ * @version 1.0
+ */
+static inline int16x4_t NeonAreaToCover(int32x4_t cover, int32x4_t area, bool evenOdd)
+{
+    int32x4_t value = vsubq_s32(vshlq_n_s32(cover, POLY_SUBPIXEL_SHIFT + 1), area);
+    value = vabsq_s32(vshrq_n_s32(value, POLY_SUBPIXEL_SHIFT * 2 + 1 - RasterizerScanlineAntialias::AA_SHIFT));
+    if (evenOdd) {
+        value = vandq_s32(value, vdupq_n_s32(RasterizerScanlineAntialias::AA_MASK2));
+        uint32x4_t fold = vcgtq_s32(value, vdupq_n_s32(RasterizerScanlineAntialias::AA_SCALE));
+        value = vbslq_s32(fold, vsubq_s32(vdupq_n_s32(RasterizerScanlineAntialias::AA_SCALE2), value), value);
+    }
+    return vmovn_s32(vminq_s32(value, vdupq_n_s32(RasterizerScanlineAntialias::AA_MASK)));
+}
+#endif
+
+/**
+ * @brief Prefix sum the cover deltas of a dense row and convert every pixel to its coverage index,
+ * which is what CalculateAlpha computes before the gamma lookup.
+ * @since 1.0
+ * @version 1.0
+ */
+static void AccumulateCoverRow(const int32_t* coverDelta, const int32_t* area, uint8_t* alpha,
+                               uint32_t width, bool evenOdd)
+{
+    uint32_t index = 0;
+    int32_t cover = 0;
+#ifdef ARM_NEON_OPT
+    int32x4_t carry = vdupq_n_s32(0);
+    for (; index + NEON_STEP_8 <= width; index += NEON_STEP_8) {
+        int32x4_t coverLow = NeonPrefixSum(vld1q_s32(coverDelta + index), carry);
+        int32x4_t coverHigh = NeonPrefixSum(vld1q_s32(coverDelta + index + NEON_STEP_4),
+                                            vdupq_n_s32(vgetq_lane_s32(coverLow, 3))); // 3: the last lane
+        carry = vdupq_n_s32(vgetq_lane_s32(coverHigh, 3)); // 3: the last lane
+        int16x8_t covers = vcombine_s16(NeonAreaToCover(coverLow, vld1q_s32(area + index), evenOdd),
+                                        NeonAreaToCover(coverHigh, vld1q_s32(area + index + NEON_STEP_4), evenOdd));
+        vst1_u8(alpha + index, vqmovun_s16(covers));
+    }
+    cover = vgetq_lane_s32(carry, 0);
+#endif
+    for (; index < width; index++) {
+        cover += coverDelta[index];
+        int32_t value = ((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area[index]) >>
+                        (POLY_SUBPIXEL_SHIFT * 2 + 1 - RasterizerScanlineAntialias::AA_SHIFT);
+        if (value < 0) {
+            value = -value;
+        }
+        if (evenOdd) {
+            value &= RasterizerScanlineAntialias::AA_MASK2;
+            if (value > RasterizerScanlineAntialias::AA_SCALE) {
+                value = RasterizerScanlineAntialias::AA_SCALE2 - value;
             }
-            if (numCells && (curCell != nullptr) && curCell->x > x) {
-                // At this time, area is 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
-                alpha = CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
-                if (alpha) {
-                    sl.AddSpan(x, curCell->x - x, alpha);
+        }
+        alpha[index] = static_cast<uint8_t>(
+            MATH_MIN(value, static_cast<int32_t>(RasterizerScanlineAntialias::AA_MASK)));
+    }
+}
+
+/**
+ * @brief Apply the gamma to a row of coverage indexes and add its runs of non-zero alpha to the scanline,
+ * the long runs of one alpha, such as the interior of a shape, as solid spans.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+static void AddAlphaRuns(Scanline& sl, int32_t startX, uint8_t* alpha, uint32_t width, const int32_t* gamma)
+{
+    for (uint32_t index = 0; index < width; index++) {
+        alpha[index] = static_cast<uint8_t>(gamma[alpha[index]]);
+    }
+
+    uint32_t index = 0;
+    while (index < width) {
+        if (alpha[index] == 0) {
+            index++;
+            continue;
+        }
+        uint32_t runStart = index;
+        while (index < width && alpha[index] != 0) {
+            uint32_t solidStart = index;
+            while (index < width && alpha[index] == alpha[solidStart]) {
+                index++;
+            }
+            if (index - solidStart >= RasterizerScanlineAntialias::SOLID_RUN_MIN_PIXELS) {
+                if (solidStart > runStart) {
+                    sl.AddCells(startX + static_cast<int32_t>(runStart), solidStart - runStart, alpha + runStart);
                 }
+                sl.AddSpan(startX + static_cast<int32_t>(solidStart), index - solidStart, alpha[solidStart]);
+                runStart = index;
             }
         }
+        if (index > runStart) {
+            sl.AddCells(startX + static_cast<int32_t>(runStart), index - runStart, alpha + runStart);
+        }
+    }
+}
 
-        if (sl.NumSpans()) {
-            break;
+/**
+ * @brief Sweep a crowded scanline without per-cell branching: the cells are scattered into
+ * dense cover and area rows, which are accumulated and converted to coverage in bulk,
+ * then the runs of non-zero alpha are added to the scanline.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline, class CellIterator>
+bool RasterizerScanlineAntialias::SweepDenseCells(Scanline& sl, CellIterator cells, uint32_t numCells,
+                                                  int32_t startX, uint32_t width)
+{
+    if (width > accumCover_.GetSize()) {
+        uint32_t size = width + (width >> 1);
+        accumCover_.Resize(size);
+        accumArea_.Resize(size);
+        accumAlpha_.Resize(size);
+    }
+    int32_t* coverDelta = accumCover_.Data();
+    int32_t* area = accumArea_.Data();
+    uint8_t* alpha = accumAlpha_.Data();
+    if (memset_s(coverDelta, sizeof(int32_t) * width, 0, sizeof(int32_t) * width) != EOK ||
+        memset_s(area, sizeof(int32_t) * width, 0, sizeof(int32_t) * width) != EOK) {
+        GRAPHIC_LOGE("RasterizerScanlineAntialias::SweepDenseCells memset_s fail");
+        return false;
+    }
+    for (; numCells; numCells--, cells++) {
+        const CellBuildAntiAlias* curCell = GetSweepCell(cells);
+        if (curCell == nullptr) {
+            return false;
         }
-        ++scanY_;
+        coverDelta[curCell->x - startX] += curCell->cover;
+        area[curCell->x - startX] += curCell->area;
     }
+    // Like the sparse sweep, nothing is added after the last cell unless it has an area
+    if (area[width - 1] == 0) {
+        width--;
+    }
+    AccumulateCoverRow(coverDelta, area, alpha, width, fillingRule_ == FILL_EVEN_ODD);
+    AddAlphaRuns(sl, startX, alpha, width, gammar_);
+    return true;
+}
 
-    sl.Finalize(scanY_);
-    ++scanY_;
+/**
+ * @brief Sweep exactly the row y, e.g. for the rows shared by the styles of RasterizerScanlineCompound.
+ * The rows must be visited from top to bottom, so that a banded path can build its next band.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+bool RasterizerScanlineAntialias::SweepScanlineRow(Scanline& sl, int32_t y)
+{
+    while (banded_ && y > outline_.GetMaxY()) {
+        if (!RasterizeNextBand()) {
+            return false;
+        }
+    }
+    if (outline_.GetTotalCells() == 0 || y < outline_.GetMinY() || y > outline_.GetMaxY()) {
+        return false;
+    }
+    if (!SweepRow(sl, y) || sl.NumSpans() == 0) {
+        return false;
+    }
+    sl.Finalize(y);
     return true;
 }
 
+/**
+ * @brief Add the spans of the row y to the scanline, from the dense rows or from the sorted cells.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+bool RasterizerScanlineAntialias::SweepRow(Scanline& sl, int32_t y)
+{
+    sl.ResetSpans();
+    if (outline_.IsAccumulatingDense()) {
+        uint32_t width = static_cast<uint32_t>(outline_.GetMaxX() - outline_.GetMinX()) + 1;
+        if (width > accumAlpha_.GetSize()) {
+            accumAlpha_.Resize(width);
+        }
+        uint8_t* alpha = accumAlpha_.Data();
+        AccumulateCoverRow(outline_.GetDenseCoverRow(y), outline_.GetDenseAreaRow(y), alpha, width,
+                           fillingRule_ == FILL_EVEN_ODD);
+        AddAlphaRuns(sl, outline_.GetMinX(), alpha, width, gammar_);
+        return true;
+    }
+    uint32_t numCells = outline_.GetScanlineNumCells(y);
+    if (outline_.GetSortByValue()) {
+        return SweepCells(sl, outline_.GetScanlineValueCells(y), numCells);
+    }
+    return SweepCells(sl, outline_.GetScanlineCells(y), numCells);
+}
+
 /**
  * @brief Convert area cover to gamma cover value to calculate alpha.
  * @since 1.0
@@ -106,10 +345,19 @@ uint32_t RasterizerScanlineAntialias::CalculateAlpha(int32_t area) const
     return gammar_[cover];
 }
 
+RasterizerScanlineAntialias::~RasterizerScanlineAntialias()
+{
+    if (vertices_ != nullptr) {
+        GeometryArrayAllocator<RecordedVertex>::Deallocate(vertices_, maxVertices_);
+    }
+}
+
 void RasterizerScanlineAntialias::Reset()
 {
     outline_.Reset();
     status_ = STATUS_INITIAL;
+    numVertices_ = 0;
+    banded_ = false;
 }
 
 void RasterizerScanlineAntialias::ClipBox(float x1, float y1, float x2, float y2)
@@ -126,6 +374,14 @@ void RasterizerScanlineAntialias::ResetClipping()
 }
 
 void RasterizerScanlineAntialias::ClosePolygon()
+{
+    if (status_ == STATUS_LINE_TO) {
+        RecordVertex(0, 0, PATH_CMD_END_POLY | PATH_FLAGS_CLOSE);
+    }
+    CloseCurrentPolygon();
+}
+
+void RasterizerScanlineAntialias::CloseCurrentPolygon()
 {
     if (status_ == STATUS_LINE_TO) {
         clipper_.LineTo(outline_, startX_, startY_);
@@ -133,42 +389,49 @@ void RasterizerScanlineAntialias::ClosePolygon()
     }
 }
 
-void RasterizerScanlineAntialias::MoveTo(int32_t x, int32_t y)
+void RasterizerScanlineAntialias::MoveToPoint(int32_t x, int32_t y)
 {
-    if (outline_.GetSorted()) {
-        Reset();
-    }
     if (autoClose_) {
-        ClosePolygon();
+        CloseCurrentPolygon();
     }
-    clipper_.MoveTo(startX_ = RasterDepictInt::DownScale(x),
-                    startY_ = RasterDepictInt::DownScale(y));
+    clipper_.MoveTo(startX_ = x, startY_ = y);
     status_ = STATUS_MOVE_TO;
 }
 
-void RasterizerScanlineAntialias::LineTo(int32_t x, int32_t y)
+void RasterizerScanlineAntialias::LineToPoint(int32_t x, int32_t y)
 {
-    clipper_.LineTo(outline_, RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+    clipper_.LineTo(outline_, x, y);
     status_ = STATUS_LINE_TO;
 }
 
-void RasterizerScanlineAntialias::MoveToByfloat(float x, float y)
+void RasterizerScanlineAntialias::MoveTo(int32_t x, int32_t y)
 {
-    if (outline_.GetSorted()) {
+    if (IsPathSwept()) {
         Reset();
     }
-    if (autoClose_) {
-        ClosePolygon();
+    RecordVertex(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y), PATH_CMD_MOVE_TO);
+    MoveToPoint(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+}
+
+void RasterizerScanlineAntialias::LineTo(int32_t x, int32_t y)
+{
+    RecordVertex(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y), PATH_CMD_LINE_TO);
+    LineToPoint(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+}
+
+void RasterizerScanlineAntialias::MoveToByfloat(float x, float y)
+{
+    if (IsPathSwept()) {
+        Reset();
     }
-    clipper_.MoveTo(startX_ = RasterDepictInt::UpScale(x),
-                    startY_ = RasterDepictInt::UpScale(y));
-    status_ = STATUS_MOVE_TO;
+    RecordVertex(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y), PATH_CMD_MOVE_TO);
+    MoveToPoint(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
 }
 
 void RasterizerScanlineAntialias::LineToByfloat(float x, float y)
 {
-    clipper_.LineTo(outline_, RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
-    status_ = STATUS_LINE_TO;
+    RecordVertex(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y), PATH_CMD_LINE_TO);
+    LineToPoint(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
 }
 
 void RasterizerScanlineAntialias::AddVertex(float x, float y, uint32_t cmd)
@@ -182,24 +445,163 @@ void RasterizerScanlineAntialias::AddVertex(float x, float y, uint32_t cmd)
     }
 }
 
+/**
+ * @brief Record a vertex in 24.8 coordinates once SetCellBudget has set a budget,
+ * so that a path beyond the budget can be built again band by band.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::RecordVertex(int32_t x, int32_t y, uint32_t cmd)
+{
+    if (!recording_) {
+        return;
+    }
+    if (numVertices_ >= maxVertices_) {
+        uint32_t newMaxVertices = maxVertices_ + VERTEX_BLOCK_POOL + (maxVertices_ >> 1);
+        RecordedVertex* newVertices = GeometryArrayAllocator<RecordedVertex>::Allocate(newMaxVertices);
+        if (newVertices == nullptr) {
+            GRAPHIC_LOGE("RasterizerScanlineAntialias::RecordVertex allocate fail\n");
+            return;
+        }
+        if (vertices_ != nullptr) {
+            if (memcpy_s(newVertices, newMaxVertices * sizeof(RecordedVertex),
+                         vertices_, numVertices_ * sizeof(RecordedVertex)) != EOK) {
+                GRAPHIC_LOGE("RasterizerScanlineAntialias::RecordVertex memcpy_s fail\n");
+            }
+            GeometryArrayAllocator<RecordedVertex>::Deallocate(vertices_, maxVertices_);
+        }
+        vertices_ = newVertices;
+        maxVertices_ = newMaxVertices;
+    }
+    RecordedVertex& vertex = vertices_[numVertices_++];
+    vertex.x = x;
+    vertex.y = y;
+    vertex.cmd = cmd;
+}
+
 void RasterizerScanlineAntialias::Sort()
 {
     if (autoClose_) {
-        ClosePolygon();
+        CloseCurrentPolygon();
     }
     outline_.SortAllCells();
+    UpdatePeakCells();
+}
+
+void RasterizerScanlineAntialias::UpdatePeakCells()
+{
+    if (outline_.GetTotalCells() > peakCells_) {
+        peakCells_ = outline_.GetTotalCells();
+    }
+}
+
+/**
+ * @brief The path dropped cells beyond the budget: keep the bounds of the whole path, which the lines
+ * still extended, and split its rows into bands expected to fit the budget.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::StartBands()
+{
+    pathMinX_ = outline_.GetMinX();
+    pathMinY_ = MATH_MAX(outline_.GetMinY(), outline_.GetMinRow());
+    pathMaxX_ = outline_.GetMaxX();
+    pathMaxY_ = MATH_MIN(outline_.GetMaxY(), outline_.GetMaxRow());
+
+    uint32_t budgetCells = outline_.GetCellBudget();
+    uint32_t requiredCells = outline_.GetTotalCells() + outline_.GetDroppedCells();
+    uint32_t numBands = requiredCells / budgetCells + 1;
+    bandRows_ = (pathMaxY_ - pathMinY_ + 1) / static_cast<int32_t>(numBands);
+    if (bandRows_ < 1) {
+        bandRows_ = 1;
+    }
+    banded_ = true;
+}
+
+/**
+ * @brief Build the cells of the rows from top in a band by replaying the recorded vertices.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::RasterizeBand(int32_t top, int32_t rows)
+{
+    outline_.Reset();
+    outline_.SetRowRange(top, top + rows - 1);
+    status_ = STATUS_INITIAL;
+    for (uint32_t i = 0; i < numVertices_; i++) {
+        const RecordedVertex& vertex = vertices_[i];
+        if (IsMoveTo(vertex.cmd)) {
+            MoveToPoint(vertex.x, vertex.y);
+        } else if (IsVertex(vertex.cmd)) {
+            LineToPoint(vertex.x, vertex.y);
+        } else {
+            CloseCurrentPolygon();
+        }
+    }
+    if (autoClose_) {
+        CloseCurrentPolygon();
+    }
+}
+
+/**
+ * @brief Rasterize and sort the next band that has cells. A band that still exceeds
+ * the budget is halved, down to single rows, and the next band starts with the rows of StartBands again,
+ * so that a crowded part of the path does not make every later band replay the vertices for a few rows.
+ * The last band stops at the last row of the path, which SetBandRows may have limited.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineAntialias::RasterizeNextBand()
+{
+    while (bandTop_ <= pathMaxY_) {
+        int32_t rows = MATH_MIN(bandRows_, pathMaxY_ - bandTop_ + 1);
+        RasterizeBand(bandTop_, rows);
+        while (outline_.GetDroppedCells() != 0 && rows > 1) {
+            rows >>= 1;
+            RasterizeBand(bandTop_, rows);
+        }
+        if (outline_.GetDroppedCells() != 0) {
+            GRAPHIC_LOGE("RasterizerScanlineAntialias::RasterizeNextBand a single row exceeds the cell budget");
+        }
+        bandTop_ += rows;
+        outline_.SortAllCells();
+        UpdatePeakCells();
+        if (outline_.GetTotalCells() != 0) {
+            scanY_ = outline_.GetMinY();
+            return true;
+        }
+    }
+    return false;
 }
 
 bool RasterizerScanlineAntialias::RewindScanlines()
 {
     if (autoClose_) {
-        ClosePolygon();
+        CloseCurrentPolygon();
+    }
+    if (!banded_ && outline_.GetDroppedCells() != 0 && numVertices_ != 0) {
+        UpdatePeakCells();
+        StartBands();
+    }
+    if (banded_) {
+        bandTop_ = pathMinY_;
+        return RasterizeNextBand();
     }
     outline_.SortAllCells();
+    UpdatePeakCells();
     if (outline_.GetTotalCells() == 0) {
         return false;
     }
     scanY_ = outline_.GetMinY();
     return true;
 }
+
+template bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline& sl);
+template bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline32& sl);
+template bool RasterizerScanlineAntialias::SweepScanline(GeometryScanlinePacked& sl);
+template bool RasterizerScanlineAntialias::SweepScanline(GeometryScanlinePacked32& sl);
+template bool RasterizerScanlineAntialias::SweepScanlineRow(GeometryScanline& sl, int32_t y);
+template bool RasterizerScanlineAntialias::SweepScanlineRow(GeometryScanline32& sl, int32_t y);
+template bool RasterizerScanlineAntialias::SweepScanlineRow(GeometryScanlinePacked& sl, int32_t y);
+template bool RasterizerScanlineAntialias::SweepScanlineRow(GeometryScanlinePacked32& sl, int32_t y);
 } // namespace OHOS
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_binary.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+
+namespace OHOS {
+/**
+ * The cover of every covered pixel, and the number of crossings a row sorts by insertion.
+ */
+enum BinaryScale {
+    BINARY_COVER_FULL = 0xFF,
+    BINARY_INSERT_SORT_THRESHOLD = 16
+};
+
+/**
+ * @brief numerator / denominator rounded up, the denominator is positive.
+ */
+static inline int64_t CeilDiv(int64_t numerator, int64_t denominator)
+{
+    int64_t quotient = numerator / denominator;
+    return (numerator > quotient * denominator) ? quotient + 1 : quotient;
+}
+
+static void SortCrossings(RasterizerEdgesBinary::Crossing* start, uint32_t num)
+{
+    while (num > BINARY_INSERT_SORT_THRESHOLD) {
+        // Quick sort around the middle crossing, recursing into the smaller part
+        int32_t pivot = start[num >> 1].x;
+        uint32_t i = 0;
+        uint32_t j = num - 1;
+        while (true) {
+            while (start[i].x < pivot) {
+                i++;
+            }
+            while (start[j].x > pivot) {
+                j--;
+            }
+            if (i >= j) {
+                break;
+            }
+            RasterizerEdgesBinary::Crossing temp = start[i];
+            start[i++] = start[j];
+            start[j--] = temp;
+        }
+        uint32_t left = j + 1;
+        if (left < num - left) {
+            SortCrossings(start, left);
+            start += left;
+            num -= left;
+        } else {
+            SortCrossings(start + left, num - left);
+            num = left;
+        }
+    }
+    for (uint32_t i = 1; i < num; i++) {
+        RasterizerEdgesBinary::Crossing crossing = start[i];
+        uint32_t j = i;
+        for (; j > 0 && start[j - 1].x > crossing.x; j--) {
+            start[j] = start[j - 1];
+        }
+        start[j] = crossing;
+    }
+}
+
+RasterizerEdgesBinary::RasterizerEdgesBinary()
+    : edges_(nullptr),
+      numEdges_(0),
+      maxEdges_(0),
+      numCrossings_(0),
+      minX_(INT32_MAX),
+      maxX_(INT32_MIN),
+      minRow_(INT32_MAX),
+      maxRow_(INT32_MIN),
+      sorted_(false) {}
+
+RasterizerEdgesBinary::~RasterizerEdgesBinary()
+{
+    if (edges_ != nullptr) {
+        GeometryArrayAllocator<BinaryEdge>::Deallocate(edges_, maxEdges_);
+    }
+}
+
+void RasterizerEdgesBinary::Reset()
+{
+    numEdges_ = 0;
+    numCrossings_ = 0;
+    minX_ = INT32_MAX;
+    maxX_ = INT32_MIN;
+    minRow_ = INT32_MAX;
+    maxRow_ = INT32_MIN;
+    sorted_ = false;
+}
+
+/**
+ * @brief Keep an edge with the rows whose center it crosses, from its top up to but excluding its bottom,
+ * so a vertex shared by two edges is counted once.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerEdgesBinary::LineOperate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    int32_t top = MATH_MIN(y1, y2);
+    int32_t bottom = MATH_MAX(y1, y2);
+    // The first row whose center is at or below top, and the last one above bottom
+    int32_t firstRow = (top + POLY_SUBPIXEL_MASK - (POLY_SUBPIXEL_SCALE >> 1)) >> POLY_SUBPIXEL_SHIFT;
+    int32_t lastRow = ((bottom + POLY_SUBPIXEL_MASK - (POLY_SUBPIXEL_SCALE >> 1)) >> POLY_SUBPIXEL_SHIFT) - 1;
+    if (firstRow > lastRow) {
+        return;
+    }
+    if (numEdges_ >= maxEdges_) {
+        uint32_t newMaxEdges = maxEdges_ + EDGE_BLOCK_POOL + (maxEdges_ >> 1);
+        BinaryEdge* newEdges = GeometryArrayAllocator<BinaryEdge>::Allocate(newMaxEdges);
+        if (newEdges == nullptr) {
+            GRAPHIC_LOGE("RasterizerEdgesBinary::LineOperate allocate fail\n");
+            return;
+        }
+        if (edges_ != nullptr) {
+            if (memcpy_s(newEdges, newMaxEdges * sizeof(BinaryEdge), edges_, numEdges_ * sizeof(BinaryEdge)) != EOK) {
+                GRAPHIC_LOGE("RasterizerEdgesBinary::LineOperate memcpy_s fail\n");
+            }
+            GeometryArrayAllocator<BinaryEdge>::Deallocate(edges_, maxEdges_);
+        }
+        edges_ = newEdges;
+        maxEdges_ = newMaxEdges;
+    }
+    BinaryEdge& edge = edges_[numEdges_++];
+    edge.x1 = x1;
+    edge.y1 = y1;
+    edge.x2 = x2;
+    edge.y2 = y2;
+    edge.firstRow = firstRow;
+    edge.lastRow = lastRow;
+    minX_ = MATH_MIN(minX_, MATH_MIN(x1, x2));
+    maxX_ = MATH_MAX(maxX_, MATH_MAX(x1, x2));
+    minRow_ = MATH_MIN(minRow_, firstRow);
+    maxRow_ = MATH_MAX(maxRow_, lastRow);
+}
+
+void RasterizerEdgesBinary::SortAllCrossings()
+{
+    if (sorted_) {
+        return;
+    }
+    sorted_ = true;
+    numCrossings_ = 0;
+    if (numEdges_ == 0) {
+        return;
+    }
+    uint32_t rows = static_cast<uint32_t>(maxRow_ - minRow_) + 1;
+    if (rowStart_.GetSize() < rows + 1) {
+        rowStart_.Resize(rows + 1);
+    }
+    uint32_t* rowStart = rowStart_.Data();
+    if (memset_s(rowStart, rowStart_.GetSize() * sizeof(uint32_t), 0, (rows + 1) * sizeof(uint32_t)) != EOK) {
+        GRAPHIC_LOGE("RasterizerEdgesBinary::SortAllCrossings memset_s fail\n");
+        return;
+    }
+    for (uint32_t i = 0; i < numEdges_; i++) {
+        for (int32_t row = edges_[i].firstRow; row <= edges_[i].lastRow; row++) {
+            ++rowStart[row - minRow_ + 1];
+        }
+    }
+    for (uint32_t row = 0; row < rows; row++) {
+        rowStart[row + 1] += rowStart[row];
+    }
+    numCrossings_ = rowStart[rows];
+    if (crossings_.GetSize() < numCrossings_) {
+        crossings_.Resize(numCrossings_);
+    }
+
+    // The crossing of a row center is at x1 + (centerY - y1) * dx / dy, the first pixel whose center
+    // is at or right of it is ceil((x - 0.5 pixel) / 1 pixel), computed exactly as one fraction
+    const int64_t halfPixel = POLY_SUBPIXEL_SCALE >> 1;
+    Crossing* crossings = crossings_.Data();
+    for (uint32_t i = 0; i < numEdges_; i++) {
+        const BinaryEdge& edge = edges_[i];
+        int64_t dx = edge.x2 - edge.x1;
+        int64_t dy = edge.y2 - edge.y1;
+        int32_t dir = (dy > 0) ? 1 : -1;
+        int64_t centerY = (static_cast<int64_t>(edge.firstRow) << POLY_SUBPIXEL_SHIFT) + halfPixel;
+        int64_t numerator = (edge.x1 - halfPixel) * dy + (centerY - edge.y1) * dx;
+        int64_t denominator = dy << POLY_SUBPIXEL_SHIFT;
+        int64_t step = dx << POLY_SUBPIXEL_SHIFT;
+        if (dy < 0) {
+            numerator = -numerator;
+            denominator = -denominator;
+            step = -step;
+        }
+        for (int32_t row = edge.firstRow; row <= edge.lastRow; row++) {
+            Crossing& crossing = crossings[rowStart[row - minRow_]++];
+            crossing.x = static_cast<int32_t>(CeilDiv(numerator, denominator));
+            crossing.dir = dir;
+            numerator += step;
+        }
+    }
+    // Filling moved every start to the end of its row, which is the start of the next one
+    for (uint32_t row = rows; row > 0; row--) {
+        rowStart[row] = rowStart[row - 1];
+    }
+    rowStart[0] = 0;
+
+    for (uint32_t row = 0; row < rows; row++) {
+        SortCrossings(crossings + rowStart[row], rowStart[row + 1] - rowStart[row]);
+    }
+}
+
+void RasterizerScanlineBinary::Reset()
+{
+    outline_.Reset();
+    status_ = STATUS_INITIAL;
+}
+
+void RasterizerScanlineBinary::ClipBox(float x1, float y1, float x2, float y2)
+{
+    Reset();
+    clipper_.ClipBox(RasterDepictInt::UpScale(x1), RasterDepictInt::UpScale(y1),
+                     RasterDepictInt::UpScale(x2), RasterDepictInt::UpScale(y2));
+}
+
+void RasterizerScanlineBinary::ResetClipping()
+{
+    Reset();
+    clipper_.ResetClipping();
+}
+
+void RasterizerScanlineBinary::ClosePolygon()
+{
+    if (status_ == STATUS_LINE_TO) {
+        clipper_.LineTo(outline_, startX_, startY_);
+        status_ = STATUS_CLOSED;
+    }
+}
+
+void RasterizerScanlineBinary::MoveTo(int32_t x, int32_t y)
+{
+    if (outline_.GetSorted()) {
+        Reset();
+    }
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    clipper_.MoveTo(startX_ = RasterDepictInt::DownScale(x),
+                    startY_ = RasterDepictInt::DownScale(y));
+    status_ = STATUS_MOVE_TO;
+}
+
+void RasterizerScanlineBinary::LineTo(int32_t x, int32_t y)
+{
+    clipper_.LineTo(outline_, RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+    status_ = STATUS_LINE_TO;
+}
+
+void RasterizerScanlineBinary::MoveToByfloat(float x, float y)
+{
+    if (outline_.GetSorted()) {
+        Reset();
+    }
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    clipper_.MoveTo(startX_ = RasterDepictInt::UpScale(x),
+                    startY_ = RasterDepictInt::UpScale(y));
+    status_ = STATUS_MOVE_TO;
+}
+
+void RasterizerScanlineBinary::LineToByfloat(float x, float y)
+{
+    clipper_.LineTo(outline_, RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
+    status_ = STATUS_LINE_TO;
+}
+
+void RasterizerScanlineBinary::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveToByfloat(x, y);
+    } else if (IsVertex(cmd)) {
+        LineToByfloat(x, y);
+    } else if (IsClose(cmd)) {
+        ClosePolygon();
+    }
+}
+
+bool RasterizerScanlineBinary::RewindScanlines()
+{
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    outline_.SortAllCrossings();
+    if (outline_.GetTotalCrossings() == 0) {
+        return false;
+    }
+    scanY_ = outline_.GetMinY();
+    return true;
+}
+
+/**
+ * @brief Walk the sorted crossings of a row keeping the winding number, the pixels from a crossing
+ * entering the path up to the next one leaving it form a solid span.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+bool RasterizerScanlineBinary::SweepScanline(Scanline& sl)
+{
+    bool evenOdd = (fillingRule_ == FILL_EVEN_ODD);
+    while (true) {
+        if (scanY_ > outline_.GetMaxY()) {
+            return false;
+        }
+        sl.ResetSpans();
+        uint32_t numCrossings = outline_.GetScanlineNumCrossings(scanY_);
+        const RasterizerEdgesBinary::Crossing* crossings = outline_.GetScanlineCrossings(scanY_);
+        int32_t winding = 0;
+        int32_t spanStart = 0;
+        for (uint32_t i = 0; i < numCrossings; i++) {
+            bool wasInside = evenOdd ? ((winding & 1) != 0) : (winding != 0);
+            winding += crossings[i].dir;
+            bool inside = evenOdd ? ((winding & 1) != 0) : (winding != 0);
+            if (inside == wasInside) {
+                continue;
+            }
+            int32_t x = crossings[i].x;
+            if (inside) {
+                spanStart = x;
+            } else if (x > spanStart) {
+                sl.AddSpan(spanStart, static_cast<uint32_t>(x - spanStart), BINARY_COVER_FULL);
+            }
+        }
+        if (sl.NumSpans()) {
+            break;
+        }
+        ++scanY_;
+    }
+
+    sl.Finalize(scanY_);
+    ++scanY_;
+    return true;
+}
+
+template bool RasterizerScanlineBinary::SweepScanline(GeometryScanline& sl);
+template bool RasterizerScanlineBinary::SweepScanline(GeometryScanline32& sl);
+template bool RasterizerScanlineBinary::SweepScanline(GeometryScanlinePacked& sl);
+template bool RasterizerScanlineBinary::SweepScanline(GeometryScanlinePacked32& sl);
+} // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_clip.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_binary.h"
 
 namespace OHOS {
 /**
@@ -23,7 +24,8 @@ namespace OHOS {
  * @since 1.0
  * @version 1.0
  */
-void RasterizerScanlineClip::LineClipY(RasterizerCellsAntiAlias& ras,
+template <class Outline>
+void RasterizerScanlineClip::LineClipY(Outline& ras,
                                        int32_t x1, int32_t y1,
                                        int32_t x2, int32_t y2,
                                        uint32_t clipFlagsOne, uint32_t clipFlagsTwo) const
@@ -102,7 +104,8 @@ void RasterizerScanlineClip::LineClipY(RasterizerCellsAntiAlias& ras,
  * @since 1.0
  * @version 1.0
  */
-void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_t x2, int32_t y2)
+template <class Outline>
+void RasterizerScanlineClip::LineTo(Outline& rasterLine, int32_t x2, int32_t y2)
 {
     if (clipping_) {
         uint32_t cFlagsLineToPoint = ClippingFlags(x2, y2, clipBox_);
@@ -228,4 +231,7 @@ void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_
     x1_ = x2;
     y1_ = y2;
 }
+
+template void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_t x2, int32_t y2);
+template void RasterizerScanlineClip::LineTo(RasterizerEdgesBinary& rasterLine, int32_t x2, int32_t y2);
 } // namespace OHOS
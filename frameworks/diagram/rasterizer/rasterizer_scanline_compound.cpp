@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_compound.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+
+namespace OHOS {
+/**
+ * @brief Grow an array to newCapacity zeroed elements, keeping its first used elements.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class T>
+static bool GrowStyleArray(T*& data, uint32_t capacity, uint32_t newCapacity, uint32_t used)
+{
+    T* newData = GeometryArrayAllocator<T>::Allocate(newCapacity);
+    if (newData == nullptr) {
+        GRAPHIC_LOGE("RasterizerScanlineCompound::GrowStyleArray allocate fail\n");
+        return false;
+    }
+    if (memset_s(newData, newCapacity * sizeof(T), 0, newCapacity * sizeof(T)) != EOK) {
+        GRAPHIC_LOGE("RasterizerScanlineCompound::GrowStyleArray memset_s fail\n");
+    }
+    if (data != nullptr) {
+        if (used != 0 && memcpy_s(newData, newCapacity * sizeof(T), data, used * sizeof(T)) != EOK) {
+            GRAPHIC_LOGE("RasterizerScanlineCompound::GrowStyleArray memcpy_s fail\n");
+        }
+        GeometryArrayAllocator<T>::Deallocate(data, capacity);
+    }
+    data = newData;
+    return true;
+}
+
+RasterizerScanlineCompound::RasterizerScanlineCompound(uint32_t cellBlockLimit)
+    : styles_(nullptr),
+      usedStyles_(nullptr),
+      scanStyles_(nullptr),
+      maxStyles_(0),
+      numUsed_(0),
+      maxUsed_(0),
+      numActive_(0),
+      numScanStyles_(0),
+      currStyle_(0),
+      current_(nullptr),
+      cellBlockLimit_(cellBlockLimit),
+      clipLeft_(0),
+      clipTop_(0),
+      clipRight_(0),
+      clipBottom_(0),
+      clipping_(false),
+      autoClose_(true),
+      sorted_(false),
+      scanY_(0),
+      currY_(0),
+      minX_(INT32_MAX),
+      minY_(INT32_MAX),
+      maxX_(INT32_MIN),
+      maxY_(INT32_MIN) {}
+
+RasterizerScanlineCompound::~RasterizerScanlineCompound()
+{
+    if (styles_ != nullptr) {
+        for (uint32_t style = 0; style < maxStyles_; style++) {
+            delete styles_[style];
+        }
+        GeometryArrayAllocator<RasterizerScanlineAntialias*>::Deallocate(styles_, maxStyles_);
+    }
+    if (usedStyles_ != nullptr) {
+        GeometryArrayAllocator<uint32_t>::Deallocate(usedStyles_, maxUsed_);
+    }
+    if (scanStyles_ != nullptr) {
+        GeometryArrayAllocator<uint32_t>::Deallocate(scanStyles_, maxUsed_);
+    }
+}
+
+void RasterizerScanlineCompound::Reset()
+{
+    for (uint32_t i = 0; i < numUsed_; i++) {
+        styles_[usedStyles_[i]]->Reset();
+    }
+    numUsed_ = 0;
+    numActive_ = 0;
+    numScanStyles_ = 0;
+    current_ = nullptr;
+    sorted_ = false;
+    minX_ = INT32_MAX;
+    minY_ = INT32_MAX;
+    maxX_ = INT32_MIN;
+    maxY_ = INT32_MIN;
+}
+
+void RasterizerScanlineCompound::ClipBox(float x1, float y1, float x2, float y2)
+{
+    Reset();
+    clipLeft_ = x1;
+    clipTop_ = y1;
+    clipRight_ = x2;
+    clipBottom_ = y2;
+    clipping_ = true;
+    for (uint32_t style = 0; style < maxStyles_; style++) {
+        if (styles_[style] != nullptr) {
+            styles_[style]->ClipBox(x1, y1, x2, y2);
+        }
+    }
+}
+
+void RasterizerScanlineCompound::ResetClipping()
+{
+    Reset();
+    clipping_ = false;
+    for (uint32_t style = 0; style < maxStyles_; style++) {
+        if (styles_[style] != nullptr) {
+            styles_[style]->ResetClipping();
+        }
+    }
+}
+
+void RasterizerScanlineCompound::AutoClose(bool flag)
+{
+    autoClose_ = flag;
+    for (uint32_t style = 0; style < maxStyles_; style++) {
+        if (styles_[style] != nullptr) {
+            styles_[style]->AutoClose(flag);
+        }
+    }
+}
+
+void RasterizerScanlineCompound::SetStyle(uint32_t style)
+{
+    if (sorted_) {
+        Reset();
+    }
+    if (style >= MAX_STYLE_ID) {
+        GRAPHIC_LOGE("RasterizerScanlineCompound::SetStyle style out of range\n");
+    }
+    currStyle_ = style;
+    current_ = nullptr;
+}
+
+/**
+ * @brief Create the rasterizer of a style on first use and add the style to the ones of the current paths.
+ * @return False for a style at or above MAX_STYLE_ID, or when an array cannot grow.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineCompound::UseStyle(uint32_t style)
+{
+    if (style >= MAX_STYLE_ID) {
+        return false;
+    }
+    if (style >= maxStyles_) {
+        // Both terms are bounded by MAX_STYLE_ID, so the sum cannot wrap
+        uint32_t newMaxStyles = MATH_MAX(style + 1, maxStyles_ + (maxStyles_ >> 1)) + STYLE_BLOCK_POOL;
+        newMaxStyles = MATH_MIN(newMaxStyles, static_cast<uint32_t>(MAX_STYLE_ID));
+        if (!GrowStyleArray(styles_, maxStyles_, newMaxStyles, maxStyles_)) {
+            return false;
+        }
+        maxStyles_ = newMaxStyles;
+    }
+    if (styles_[style] == nullptr) {
+        RasterizerScanlineAntialias* ras = new RasterizerScanlineAntialias(cellBlockLimit_);
+        if (clipping_) {
+            ras->ClipBox(clipLeft_, clipTop_, clipRight_, clipBottom_);
+        }
+        ras->AutoClose(autoClose_);
+        styles_[style] = ras;
+    }
+
+    for (uint32_t i = 0; i < numUsed_; i++) {
+        if (usedStyles_[i] == style) {
+            return true;
+        }
+    }
+    if (numUsed_ >= maxUsed_) {
+        uint32_t newMaxUsed = maxUsed_ + STYLE_BLOCK_POOL + (maxUsed_ >> 1);
+        if (!GrowStyleArray(usedStyles_, maxUsed_, newMaxUsed, numUsed_) ||
+            !GrowStyleArray(scanStyles_, maxUsed_, newMaxUsed, 0)) {
+            return false;
+        }
+        maxUsed_ = newMaxUsed;
+    }
+    usedStyles_[numUsed_++] = style;
+    return true;
+}
+
+RasterizerScanlineAntialias* RasterizerScanlineCompound::GetCurrentStyle()
+{
+    if (sorted_) {
+        Reset();
+    }
+    if (current_ == nullptr && UseStyle(currStyle_)) {
+        current_ = styles_[currStyle_];
+    }
+    return current_;
+}
+
+void RasterizerScanlineCompound::MoveTo(int32_t x, int32_t y)
+{
+    RasterizerScanlineAntialias* ras = GetCurrentStyle();
+    if (ras != nullptr) {
+        ras->MoveTo(x, y);
+    }
+}
+
+void RasterizerScanlineCompound::LineTo(int32_t x, int32_t y)
+{
+    RasterizerScanlineAntialias* ras = GetCurrentStyle();
+    if (ras != nullptr) {
+        ras->LineTo(x, y);
+    }
+}
+
+void RasterizerScanlineCompound::MoveToByfloat(float x, float y)
+{
+    RasterizerScanlineAntialias* ras = GetCurrentStyle();
+    if (ras != nullptr) {
+        ras->MoveToByfloat(x, y);
+    }
+}
+
+void RasterizerScanlineCompound::LineToByfloat(float x, float y)
+{
+    RasterizerScanlineAntialias* ras = GetCurrentStyle();
+    if (ras != nullptr) {
+        ras->LineToByfloat(x, y);
+    }
+}
+
+void RasterizerScanlineCompound::ClosePolygon()
+{
+    RasterizerScanlineAntialias* ras = GetCurrentStyle();
+    if (ras != nullptr) {
+        ras->ClosePolygon();
+    }
+}
+
+void RasterizerScanlineCompound::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveToByfloat(x, y);
+    } else if (IsVertex(cmd)) {
+        LineToByfloat(x, y);
+    } else if (IsClose(cmd)) {
+        ClosePolygon();
+    }
+}
+
+/**
+ * @brief Sort the used styles by id, so that every row lists them in paint order,
+ * and move the styles that have cells to the front.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineCompound::RewindScanlines()
+{
+    for (uint32_t i = 1; i < numUsed_; i++) {
+        uint32_t style = usedStyles_[i];
+        uint32_t j = i;
+        for (; j > 0 && usedStyles_[j - 1] > style; j--) {
+            usedStyles_[j] = usedStyles_[j - 1];
+        }
+        usedStyles_[j] = style;
+    }
+
+    numActive_ = 0;
+    minX_ = INT32_MAX;
+    minY_ = INT32_MAX;
+    maxX_ = INT32_MIN;
+    maxY_ = INT32_MIN;
+    for (uint32_t i = 0; i < numUsed_; i++) {
+        uint32_t style = usedStyles_[i];
+        RasterizerScanlineAntialias* ras = styles_[style];
+        if (!ras->RewindScanlines()) {
+            continue;
+        }
+        minX_ = MATH_MIN(minX_, ras->GetMinX());
+        minY_ = MATH_MIN(minY_, ras->GetMinY());
+        maxX_ = MATH_MAX(maxX_, ras->GetMaxX());
+        maxY_ = MATH_MAX(maxY_, ras->GetMaxY());
+        usedStyles_[i] = usedStyles_[numActive_];
+        usedStyles_[numActive_++] = style;
+    }
+    sorted_ = true;
+    current_ = nullptr;
+    numScanStyles_ = 0;
+    scanY_ = minY_;
+    return numActive_ != 0;
+}
+
+uint32_t RasterizerScanlineCompound::SweepStyles()
+{
+    while (numActive_ != 0 && scanY_ <= maxY_) {
+        int32_t y = scanY_++;
+        int32_t nextY = INT32_MAX;
+        numScanStyles_ = 0;
+        for (uint32_t i = 0; i < numActive_; i++) {
+            const RasterizerScanlineAntialias* ras = styles_[usedStyles_[i]];
+            if (ras->GetMinY() > y) {
+                nextY = MATH_MIN(nextY, ras->GetMinY());
+            } else if (ras->GetMaxY() >= y) {
+                scanStyles_[numScanStyles_++] = usedStyles_[i];
+            }
+        }
+        if (numScanStyles_ != 0) {
+            currY_ = y;
+            return numScanStyles_;
+        }
+        // Skip the rows between the styles
+        scanY_ = MATH_MAX(scanY_, nextY);
+    }
+    numScanStyles_ = 0;
+    return 0;
+}
+
+template <class Scanline>
+bool RasterizerScanlineCompound::SweepScanline(Scanline& sl, uint32_t index)
+{
+    if (index >= numScanStyles_) {
+        return false;
+    }
+    return styles_[scanStyles_[index]]->SweepScanlineRow(sl, currY_);
+}
+
+template bool RasterizerScanlineCompound::SweepScanline(GeometryScanline& sl, uint32_t index);
+template bool RasterizerScanlineCompound::SweepScanline(GeometryScanline32& sl, uint32_t index);
+template bool RasterizerScanlineCompound::SweepScanline(GeometryScanlinePacked& sl, uint32_t index);
+template bool RasterizerScanlineCompound::SweepScanline(GeometryScanlinePacked32& sl, uint32_t index);
+} // namespace OHOS
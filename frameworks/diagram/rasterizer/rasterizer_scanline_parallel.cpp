@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_parallel.h"
+#include "gfx_utils/graphic_log.h"
+#include "graphic_semaphore.h"
+#include "graphic_thread.h"
+#include "hal_cpu.h"
+#include "securec.h"
+
+namespace OHOS {
+#ifdef _WIN32
+static DWORD WINAPI RasterBandEntry(LPVOID arg)
+#else
+static void* RasterBandEntry(void* arg)
+#endif
+{
+    RasterizerScanlineParallel::BandTask* task = static_cast<RasterizerScanlineParallel::BandTask*>(arg);
+    task->owner->RunBandWorker(task->band);
+    return 0;
+}
+
+RasterizerScanlineParallel::RasterizerScanlineParallel(uint32_t cellBlockLimit)
+    : vertices_(nullptr),
+      numVertices_(0),
+      maxVertices_(0),
+      cellBlockLimit_(cellBlockLimit),
+      maxBands_(0),
+      numBands_(0),
+      currBand_(0),
+      clipLeft_(0),
+      clipTop_(0),
+      clipRight_(0),
+      clipBottom_(0),
+      clipping_(false),
+      autoClose_(true),
+      sorted_(false),
+      stopWorkers_(false),
+      minX_(INT32_MAX),
+      minY_(INT32_MAX),
+      maxX_(INT32_MIN),
+      maxY_(INT32_MIN)
+{
+    for (uint32_t band = 0; band < MAX_BANDS; band++) {
+        bands_[band] = nullptr;
+        bandDone_[band] = nullptr;
+        bandStart_[band] = nullptr;
+        bandWorker_[band] = false;
+        bandTasks_[band].owner = this;
+        bandTasks_[band].band = band;
+        bandPending_[band] = false;
+        bandHasCells_[band] = false;
+    }
+}
+
+RasterizerScanlineParallel::~RasterizerScanlineParallel()
+{
+    WaitAllBands();
+    // Wake the workers to quit, each acknowledges on its done semaphore before the semaphores are deleted
+    stopWorkers_ = true;
+    for (uint32_t band = 0; band < MAX_BANDS; band++) {
+        if (bandWorker_[band]) {
+            bandStart_[band]->Notify();
+            bandDone_[band]->Wait();
+        }
+    }
+    for (uint32_t band = 0; band < MAX_BANDS; band++) {
+        delete bands_[band];
+        delete bandDone_[band];
+        delete bandStart_[band];
+    }
+    if (vertices_ != nullptr) {
+        GeometryArrayAllocator<BandVertex>::Deallocate(vertices_, maxVertices_);
+    }
+}
+
+void RasterizerScanlineParallel::Reset()
+{
+    WaitAllBands();
+    numVertices_ = 0;
+    numBands_ = 0;
+    currBand_ = 0;
+    sorted_ = false;
+    minX_ = INT32_MAX;
+    minY_ = INT32_MAX;
+    maxX_ = INT32_MIN;
+    maxY_ = INT32_MIN;
+}
+
+void RasterizerScanlineParallel::ClipBox(float x1, float y1, float x2, float y2)
+{
+    Reset();
+    clipLeft_ = MATH_MIN(x1, x2);
+    clipRight_ = MATH_MAX(x1, x2);
+    clipTop_ = MATH_MIN(y1, y2);
+    clipBottom_ = MATH_MAX(y1, y2);
+    clipping_ = true;
+}
+
+void RasterizerScanlineParallel::ResetClipping()
+{
+    Reset();
+    clipping_ = false;
+}
+
+/**
+ * @brief Record a vertex of the path in 24.8 coordinates, the bands replay them on rewind.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineParallel::AddBandVertex(int32_t x, int32_t y, uint32_t cmd)
+{
+    if (sorted_) {
+        Reset();
+    }
+    if (numVertices_ >= maxVertices_) {
+        uint32_t newMaxVertices = maxVertices_ + VERTEX_BLOCK_POOL + (maxVertices_ >> 1);
+        BandVertex* newVertices = GeometryArrayAllocator<BandVertex>::Allocate(newMaxVertices);
+        if (newVertices == nullptr) {
+            GRAPHIC_LOGE("RasterizerScanlineParallel::AddBandVertex allocate fail\n");
+            return;
+        }
+        if (vertices_ != nullptr) {
+            if (memcpy_s(newVertices, newMaxVertices * sizeof(BandVertex),
+                         vertices_, numVertices_ * sizeof(BandVertex)) != EOK) {
+                GRAPHIC_LOGE("RasterizerScanlineParallel::AddBandVertex memcpy_s fail\n");
+            }
+            GeometryArrayAllocator<BandVertex>::Deallocate(vertices_, maxVertices_);
+        }
+        vertices_ = newVertices;
+        maxVertices_ = newMaxVertices;
+    }
+    BandVertex& vertex = vertices_[numVertices_++];
+    vertex.x = x;
+    vertex.y = y;
+    vertex.cmd = cmd;
+    if (IsVertex(cmd)) {
+        int32_t pixelX = x >> POLY_SUBPIXEL_SHIFT;
+        int32_t pixelY = y >> POLY_SUBPIXEL_SHIFT;
+        minX_ = MATH_MIN(minX_, pixelX);
+        maxX_ = MATH_MAX(maxX_, pixelX);
+        minY_ = MATH_MIN(minY_, pixelY);
+        maxY_ = MATH_MAX(maxY_, pixelY);
+    }
+}
+
+void RasterizerScanlineParallel::MoveTo(int32_t x, int32_t y)
+{
+    AddBandVertex(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y), PATH_CMD_MOVE_TO);
+}
+
+void RasterizerScanlineParallel::LineTo(int32_t x, int32_t y)
+{
+    AddBandVertex(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y), PATH_CMD_LINE_TO);
+}
+
+void RasterizerScanlineParallel::MoveToByfloat(float x, float y)
+{
+    AddBandVertex(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y), PATH_CMD_MOVE_TO);
+}
+
+void RasterizerScanlineParallel::LineToByfloat(float x, float y)
+{
+    AddBandVertex(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y), PATH_CMD_LINE_TO);
+}
+
+void RasterizerScanlineParallel::ClosePolygon()
+{
+    AddBandVertex(0, 0, PATH_CMD_END_POLY | PATH_FLAGS_CLOSE);
+}
+
+void RasterizerScanlineParallel::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveToByfloat(x, y);
+    } else if (IsVertex(cmd)) {
+        LineToByfloat(x, y);
+    } else if (IsClose(cmd)) {
+        ClosePolygon();
+    }
+}
+
+/**
+ * @brief The number of bands follows the CPU cores, but every band keeps at least MIN_BAND_ROWS rows.
+ * @since 1.0
+ * @version 1.0
+ */
+uint32_t RasterizerScanlineParallel::CalculateBands() const
+{
+    uint32_t numBands = (maxBands_ != 0) ? maxBands_ : HalGetCpuCoreNum();
+    uint32_t rows = static_cast<uint32_t>(maxY_ - minY_ + 1);
+    numBands = MATH_MIN(numBands, static_cast<uint32_t>(MAX_BANDS));
+    numBands = MATH_MIN(numBands, rows / MIN_BAND_ROWS);
+    return (numBands == 0) ? 1 : numBands;
+}
+
+bool RasterizerScanlineParallel::RewindScanlines()
+{
+    WaitAllBands();
+    if (numVertices_ == 0) {
+        return false;
+    }
+    if (clipping_) {
+        minX_ = MATH_MAX(minX_, static_cast<int32_t>(clipLeft_));
+        maxX_ = MATH_MIN(maxX_, static_cast<int32_t>(clipRight_));
+        minY_ = MATH_MAX(minY_, static_cast<int32_t>(clipTop_));
+        maxY_ = MATH_MIN(maxY_, static_cast<int32_t>(clipBottom_));
+    }
+    sorted_ = true;
+    currBand_ = 0;
+    numBands_ = 0;
+    if (minX_ > maxX_ || minY_ > maxY_) {
+        return false;
+    }
+
+    numBands_ = CalculateBands();
+    uint32_t rows = static_cast<uint32_t>(maxY_ - minY_ + 1);
+    for (uint32_t band = 0; band < numBands_; band++) {
+        bandTop_[band] = minY_ + static_cast<int32_t>(rows * band / numBands_);
+        if (bands_[band] == nullptr) {
+            bands_[band] = NewBand();
+        }
+        bandHasCells_[band] = false;
+    }
+    bandTop_[numBands_] = maxY_ + 1;
+
+    // The calling thread takes the first band, the others go to the worker threads
+    for (uint32_t band = 1; band < numBands_; band++) {
+        if (!StartBandWorker(band)) {
+            RasterizeBand(band);
+            continue;
+        }
+        bandPending_[band] = true;
+        bandStart_[band]->Notify();
+    }
+    RasterizeBand(0);
+    return true;
+}
+
+/**
+ * @brief Create the rasterizer of a band, with the cell budget set so that it records the vertices
+ * and sweeps a band over the budget in smaller bands instead of losing cells.
+ * @since 1.0
+ * @version 1.0
+ */
+RasterizerScanlineAntialias* RasterizerScanlineParallel::NewBand() const
+{
+    RasterizerScanlineAntialias* ras = new RasterizerScanlineAntialias(cellBlockLimit_);
+    ras->SetCellBudget(cellBlockLimit_);
+    return ras;
+}
+
+/**
+ * @brief Start the worker thread of a band the first time the band is needed,
+ * it then waits for every later rewind instead of a thread being created per rewind.
+ * @return Whether the band has a worker, or has to be rasterized by the calling thread.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineParallel::StartBandWorker(uint32_t band)
+{
+    if (bandWorker_[band]) {
+        return true;
+    }
+    if (bandDone_[band] == nullptr) {
+        bandDone_[band] = new GraphicSemaphore();
+    }
+    if (bandStart_[band] == nullptr) {
+        bandStart_[band] = new GraphicSemaphore();
+    }
+    ThreadId thread = ThreadCreate(RasterBandEntry, &bandTasks_[band], nullptr);
+    if (thread == nullptr) {
+        GRAPHIC_LOGE("RasterizerScanlineParallel::StartBandWorker create thread fail\n");
+        return false;
+    }
+#ifdef _WIN32
+    // The worker runs on without its handle, like the detached threads of the other platforms
+    CloseHandle(static_cast<HANDLE>(thread));
+#endif
+    bandWorker_[band] = true;
+    return true;
+}
+
+void RasterizerScanlineParallel::RunBandWorker(uint32_t band)
+{
+    while (true) {
+        bandStart_[band]->Wait();
+        if (stopWorkers_) {
+            break;
+        }
+        RasterizeBand(band);
+    }
+    bandDone_[band]->Notify();
+}
+
+void RasterizerScanlineParallel::RasterizeBand(uint32_t band)
+{
+    RasterizerScanlineAntialias& ras = *bands_[band];
+    /*
+     * The clip box resets the band, the band rows keep only the cells of its rows.
+     * A band over its cell budget is swept in smaller bands of its own, which stop at its last row.
+     */
+    if (clipping_) {
+        ras.ClipBox(clipLeft_, clipTop_, clipRight_, clipBottom_);
+    } else {
+        ras.ResetClipping();
+    }
+    ras.SetBandRows(bandTop_[band], bandTop_[band + 1] - 1);
+    ras.AutoClose(autoClose_);
+    for (uint32_t i = 0; i < numVertices_; i++) {
+        const BandVertex& vertex = vertices_[i];
+        if (IsMoveTo(vertex.cmd)) {
+            ras.MoveTo(vertex.x, vertex.y);
+        } else if (IsVertex(vertex.cmd)) {
+            ras.LineTo(vertex.x, vertex.y);
+        } else {
+            ras.ClosePolygon();
+        }
+    }
+    bandHasCells_[band] = ras.RewindScanlines();
+    if (bandPending_[band] && bandDone_[band] != nullptr) {
+        bandDone_[band]->Notify();
+    }
+}
+
+void RasterizerScanlineParallel::WaitBand(uint32_t band)
+{
+    if (bandPending_[band]) {
+        bandDone_[band]->Wait();
+        bandPending_[band] = false;
+    }
+}
+
+void RasterizerScanlineParallel::WaitAllBands()
+{
+    for (uint32_t band = 0; band < MAX_BANDS; band++) {
+        WaitBand(band);
+    }
+}
+
+template <class Scanline>
+bool RasterizerScanlineParallel::SweepScanline(Scanline& sl)
+{
+    while (currBand_ < numBands_) {
+        WaitBand(currBand_);
+        if (bandHasCells_[currBand_] && bands_[currBand_]->SweepScanline(sl)) {
+            return true;
+        }
+        ++currBand_;
+    }
+    return false;
+}
+
+template bool RasterizerScanlineParallel::SweepScanline(GeometryScanline& sl);
+template bool RasterizerScanlineParallel::SweepScanline(GeometryScanline32& sl);
+template bool RasterizerScanlineParallel::SweepScanline(GeometryScanlinePacked& sl);
+template bool RasterizerScanlineParallel::SweepScanline(GeometryScanlinePacked32& sl);
+} // namespace OHOS
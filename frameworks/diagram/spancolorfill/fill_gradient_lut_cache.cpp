@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
+
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace OHOS {
+GradientLutCache* GradientLutCache::GetInstance()
+{
+    static GradientLutCache instance;
+    return &instance;
+}
+
+/**
+ * @brief FNV-1a hash of the key words and the table size.
+ * @since 1.0
+ * @version 1.0
+ */
+uint32_t GradientLutCache::Hash(const uint32_t* key, uint32_t keySize, uint32_t lutSize)
+{
+    const uint32_t fnvPrime = 16777619;
+    uint32_t hash = 2166136261; // 2166136261: FNV offset basis
+    hash = (hash ^ lutSize) * fnvPrime;
+    for (uint32_t i = 0; i < keySize; i++) {
+        hash = (hash ^ key[i]) * fnvPrime;
+    }
+    return hash;
+}
+
+GradientLutCache::CacheEntry* GradientLutCache::FindEntry(const Rgba8T* colors)
+{
+    for (uint32_t i = 0; i < GRADIENT_LUT_CACHE_ENTRIES; i++) {
+        if (entries_[i].lutSize != 0 && entries_[i].colors.Data() == colors) {
+            return entries_ + i;
+        }
+    }
+    return nullptr;
+}
+
+const Rgba8T* GradientLutCache::Acquire(const uint32_t* key, uint32_t keySize, uint32_t lutSize,
+                                        BuildFunction build)
+{
+    if (key == nullptr || keySize == 0 || lutSize == 0 || build == nullptr) {
+        return nullptr;
+    }
+    uint32_t hash = Hash(key, keySize, lutSize);
+    mutex_.Lock();
+    useClock_++;
+    CacheEntry* victim = nullptr;
+    for (uint32_t i = 0; i < GRADIENT_LUT_CACHE_ENTRIES; i++) {
+        CacheEntry& entry = entries_[i];
+        if (entry.lutSize == lutSize && entry.hash == hash && entry.keySize == keySize &&
+            memcmp(entry.key.Data(), key, keySize * sizeof(uint32_t)) == 0) {
+            entry.refCount++;
+            entry.lastUse = useClock_;
+            numHits_++;
+            const Rgba8T* colors = entry.colors.Data();
+            mutex_.Unlock();
+            return colors;
+        }
+        if (entry.refCount == 0 && (victim == nullptr || entry.lastUse < victim->lastUse)) {
+            victim = &entry;
+        }
+    }
+    numMisses_++;
+    if (victim == nullptr) {
+        mutex_.Unlock();
+        return nullptr;
+    }
+    victim->lutSize = 0;
+    if (victim->key.GetSize() < keySize) {
+        victim->key.Resize(keySize);
+    }
+    if (victim->colors.GetSize() < lutSize) {
+        victim->colors.Resize(lutSize);
+    }
+    if (victim->key.Data() == nullptr || victim->colors.Data() == nullptr ||
+        memcpy_s(victim->key.Data(), victim->key.GetSize() * sizeof(uint32_t), key,
+                 keySize * sizeof(uint32_t)) != EOK) {
+        GRAPHIC_LOGE("GradientLutCache::Acquire fail\n");
+        mutex_.Unlock();
+        return nullptr;
+    }
+    // Built under the lock, so that no other user sees the table half built
+    build(key, keySize, victim->colors.Data(), lutSize);
+    victim->hash = hash;
+    victim->keySize = keySize;
+    victim->lutSize = lutSize;
+    victim->refCount = 1;
+    victim->lastUse = useClock_;
+    const Rgba8T* colors = victim->colors.Data();
+    mutex_.Unlock();
+    return colors;
+}
+
+void GradientLutCache::Retain(const Rgba8T* colors)
+{
+    mutex_.Lock();
+    CacheEntry* entry = FindEntry(colors);
+    if (entry != nullptr) {
+        entry->refCount++;
+    }
+    mutex_.Unlock();
+}
+
+void GradientLutCache::Release(const Rgba8T* colors)
+{
+    mutex_.Lock();
+    CacheEntry* entry = FindEntry(colors);
+    if (entry != nullptr && entry->refCount > 0) {
+        entry->refCount--;
+    }
+    mutex_.Unlock();
+}
+} // namespace OHOS
+#endif
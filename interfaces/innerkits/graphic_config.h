@@ -411,6 +411,16 @@ namespace OHOS {
 #define ENABLE_CMATH              1
 #endif
 
+/**
+ * @brief Defines whether the rasterizer clips the edges with integer arithmetic only,
+ *        for the boards without an FPU, where float is emulated in software.
+ * 0:    Float multiply and divide
+ * 1:    64 bit integer multiply and divide
+  */
+#ifndef ENABLE_FIXED_POINT_CLIP
+#define ENABLE_FIXED_POINT_CLIP   0
+#endif
+
 /**
  * @brief Defines the file name of default vector font.
  */
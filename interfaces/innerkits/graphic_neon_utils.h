@@ -77,6 +77,37 @@ static inline float32x4_t NeonDiv(float32x4_t a, float32x4_t b)
     return vmulq_f32(a, reciprocal);
 }
 
+// return atan2(y, x)
+// y, x and result are floating-point numbers, the result in radians from -pi to pi as FastAtan2F.
+static inline float32x4_t NeonAtan2(float32x4_t y, float32x4_t x)
+{
+    float32x4_t absX = vabsq_f32(x);
+    float32x4_t absY = vabsq_f32(y);
+    // 1e-30: keeps the quotient finite at the origin
+    float32x4_t t = NeonDiv(vminq_f32(absX, absY), vmaxq_f32(vmaxq_f32(absX, absY), vdupq_n_f32(1e-30f)));
+    float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t angle = vmlaq_f32(vdupq_n_f32(ATAN2_P5), t2, vdupq_n_f32(ATAN2_P7));
+    angle = vmlaq_f32(vdupq_n_f32(ATAN2_P3), t2, angle);
+    angle = vmulq_f32(t, vmlaq_f32(vdupq_n_f32(1.0f), t2, angle));
+    // The angle in the octant, then in the quadrant, then in the half plane
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    angle = vbslq_f32(vcgtq_f32(absY, absX), vsubq_f32(vdupq_n_f32(UI_PI / 2), angle), angle); // 2: a quarter
+    angle = vbslq_f32(vcltq_f32(x, zero), vsubq_f32(vdupq_n_f32(UI_PI), angle), angle);
+    return vbslq_f32(vcltq_f32(y, zero), vnegq_f32(angle), angle);
+}
+
+// return sqrt(a)
+// a and result are non-negative floating-point numbers, the estimate of 1 / sqrt(a) refined twice.
+static inline float32x4_t NeonSqrt(float32x4_t a)
+{
+    // 1e-30: keeps the estimate finite at 0
+    a = vmaxq_f32(a, vdupq_n_f32(1e-30f));
+    float32x4_t reciprocal = vrsqrteq_f32(a);
+    reciprocal = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, reciprocal), reciprocal), reciprocal);
+    reciprocal = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, reciprocal), reciprocal), reciprocal);
+    return vmulq_f32(a, reciprocal);
+}
+
 // return a / b
 // a is a 16-bits integer, b and result are 8-bits integers.
 static inline uint8x8_t NeonDivInt(uint16x8_t a, uint8x8_t b)
@@ -16,120 +16,495 @@
 #define GRAPHIC_LITE_FILTER_BLUR_H
 
 #include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
 #include "gfx_utils/graphic_math.h"
 #include "graphic_config.h"
 #include "securec.h"
+#ifdef ARM_NEON_OPT
+#include <arm_neon.h>
+#endif
 
 namespace OHOS {
 class Filterblur {
 #if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
 
 public:
-    Filterblur()
-    {
-        integral_ = nullptr;
-        imageWidth_ = 0;
-        imageHeight_ = 0;
-    }
-    ~Filterblur()
+    /**
+     * @brief The vertical pass walks the columns in strips of BLUR_STRIP_BYTES bytes, a cache line of a row,
+     * NEON_BLUR_BYTES of which make a vector, and an average
+     * is (sum * reciprocal + BLUR_ROUND) >> BLUR_RECIPROCAL_SHIFT, the reciprocal of the pixel count
+     * being rounded up so that the halves round up as with an integer division.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum BlurScale {
+        BLUR_STRIP_BYTES = 64,
+        NEON_BLUR_BYTES = 16,
+        BLUR_RECIPROCAL_SHIFT = 24,
+        BLUR_ROUND = 1 << (BLUR_RECIPROCAL_SHIFT - 1)
+    };
+
+    /**
+     * @brief A Gaussian blur is approximated by GAUSSIAN_BOX_PASSES box blurs, and with a sigma above
+     * BLUR_DOWNSAMPLE_SIGMA it may be done on an image scaled down to bring the sigma under it.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum GaussianScale {
+        GAUSSIAN_BOX_PASSES = 3,
+        BLUR_DOWNSAMPLE_SIGMA = 4
+    };
+
+    /**
+     * @brief The channels blurred:
+     * BLUR_MODE_COLOR blurs B, G and R of a BGRA image and keeps its alpha,
+     * BLUR_MODE_PREMULTIPLIED blurs the four channels of a premultiplied BGRA image, so that the transparent
+     * pixels around a shape do not bleed their color into it,
+     * BLUR_MODE_ALPHA8 blurs an A8 mask of one byte per pixel, e.g. for a shadow, a quarter of the work.
+     * The channel given with a mode is 4, or 1 for BLUR_MODE_ALPHA8.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum BlurMode {
+        BLUR_MODE_COLOR,
+        BLUR_MODE_PREMULTIPLIED,
+        BLUR_MODE_ALPHA8
+    };
+
+    Filterblur() : reciprocalCount_(0) {}
+    ~Filterblur() {}
+
+    /**
+     * @brief Blur the channels of the mode of an image in place with a box of 2 * radius + 1 pixels,
+     * clipped at the borders of the image.
+     * The box is separable: a sliding sum runs along every row, then down every strip of columns,
+     * so only a row or a strip of columns is buffered instead of an integral image.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Img>
+    void BoxBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride, BlurMode mode = BLUR_MODE_COLOR)
     {
-        if (integral_ != nullptr) {
-            free(integral_);
+        if (radius < 1 || channel != GetPixelBytes(mode)) {
+            return;
         }
+        int32_t width = img.GetWidth();
+        int32_t height = img.GetHeight();
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+        BoxBlurImage((uint8_t*)img.PixValuePtr(0, 0), width, height, stride, radius, mode);
     }
 
+    /**
+     * @brief Blur the channels of the mode of an image in place like a Gaussian of standard deviation sigma,
+     * e.g. half the blur radius of a shadow, with three box blurs reusing the same buffers.
+     * With downsample, a sigma above BLUR_DOWNSAMPLE_SIGMA is blurred on a copy of the image scaled down
+     * by an integer factor, which is then scaled up back with bilinear interpolation,
+     * so that the cost hardly grows with the sigma.
+     * @since 1.0
+     * @version 1.0
+     */
     template <class Img>
-    void BoxBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride)
+    void GaussianBlur(Img& img, float sigma, int32_t channel, int32_t stride, bool downsample = true,
+                      BlurMode mode = BLUR_MODE_COLOR)
     {
-        if (radius < 1) {
+        if (sigma <= 0 || channel != GetPixelBytes(mode)) {
             return;
         }
         int32_t width = img.GetWidth();
         int32_t height = img.GetHeight();
-        bool isGetRGBAIntegral = false;
-        if (integral_ == nullptr || ((imageWidth_ * imageHeight_) != (width * height))) {
-            if (integral_ != nullptr) {
-                free(integral_);
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+        uint8_t* image = (uint8_t*)img.PixValuePtr(0, 0);
+        if (!downsample || sigma <= BLUR_DOWNSAMPLE_SIGMA) {
+            BoxBlurPasses(image, width, height, stride, sigma, mode);
+            return;
+        }
+        int32_t pixelBytes = GetPixelBytes(mode);
+        int32_t factor = static_cast<int32_t>(sigma / BLUR_DOWNSAMPLE_SIGMA) + 1;
+        int32_t smallWidth = (width + factor - 1) / factor;
+        int32_t smallHeight = (height + factor - 1) / factor;
+        uint32_t smallSize = static_cast<uint32_t>(smallWidth * smallHeight * pixelBytes);
+        if (smallImage_.GetSize() < smallSize) {
+            smallImage_.Resize(smallSize);
+        }
+        uint8_t* small = smallImage_.Data();
+        if (small == nullptr) {
+            return;
+        }
+        int32_t blurBytes = GetBlurBytes(mode);
+        Downsample(image, width, height, stride, small, smallWidth, smallHeight, factor, pixelBytes, blurBytes);
+        BoxBlurPasses(small, smallWidth, smallHeight, smallWidth * pixelBytes, sigma / factor, mode);
+        Upsample(small, smallWidth, smallHeight, image, width, height, stride, factor, pixelBytes, blurBytes);
+    }
+
+private:
+    static int32_t GetPixelBytes(BlurMode mode)
+    {
+        return (mode == BLUR_MODE_ALPHA8) ? 1 : FOUR_TIMES;
+    }
+
+    /**
+     * @brief The leading bytes of a pixel that are blurred, the others are kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    static int32_t GetBlurBytes(BlurMode mode)
+    {
+        if (mode == BLUR_MODE_ALPHA8) {
+            return 1;
+        }
+        return (mode == BLUR_MODE_PREMULTIPLIED) ? FOUR_TIMES : 3; // 3: blue, green and red
+    }
+
+    void BoxBlurImage(uint8_t* image, int32_t width, int32_t height, int32_t stride, uint16_t radius,
+                      BlurMode mode)
+    {
+        if (radius < 1 || !PrepareBuffers(width, height, radius, GetPixelBytes(mode))) {
+            return;
+        }
+        if (mode == BLUR_MODE_ALPHA8) {
+            BoxBlurPixels<1, 1>(image, width, height, stride, radius);
+        } else if (mode == BLUR_MODE_PREMULTIPLIED) {
+            BoxBlurPixels<FOUR_TIMES, FOUR_TIMES>(image, width, height, stride, radius);
+        } else {
+            BoxBlurPixels<FOUR_TIMES, 3>(image, width, height, stride, radius); // 3: blue, green and red
+        }
+    }
+
+    /**
+     * @brief The box blur of pixels of PIXEL_BYTES bytes whose BLUR_BYTES leading bytes are blurred,
+     * a strip holding BLUR_STRIP_BYTES / PIXEL_BYTES pixels.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <int32_t PIXEL_BYTES, int32_t BLUR_BYTES>
+    void BoxBlurPixels(uint8_t* image, int32_t width, int32_t height, int32_t stride, int32_t radius)
+    {
+        for (int32_t y = 0; y < height; y++) {
+            BlurRow<PIXEL_BYTES, BLUR_BYTES>(image + y * stride, width, radius);
+        }
+        const int32_t stripPixels = BLUR_STRIP_BYTES / PIXEL_BYTES;
+        for (int32_t x = 0; x < width; x += stripPixels) {
+            BlurStrip<PIXEL_BYTES, BLUR_BYTES>(image + x * PIXEL_BYTES, stride, MATH_MIN(stripPixels, width - x),
+                                               height, radius);
+        }
+    }
+
+    /**
+     * @brief The radii of the box blurs whose succession has the variance of a Gaussian of sigma:
+     * n boxes of widths wl or wl + 2 in a proportion that makes up for the odd widths.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void GetGaussianRadii(float sigma, uint16_t* radii)
+    {
+        const float passes = GAUSSIAN_BOX_PASSES;
+        const float variance = 12.0f * sigma * sigma; // 12: variance of a box of width w is (w * w - 1) / 12
+        int32_t lower = static_cast<int32_t>(Sqrt(variance / passes + 1.0f));
+        if ((lower & 1) == 0) {
+            lower--;
+        }
+        lower = MATH_MAX(lower, 1);
+        float widthLower = static_cast<float>(lower);
+        // 4, 3: from n * wl^2 + 4 * (n - m) * (wl + 1) = 12 * sigma^2 + n with m boxes of width wl
+        int32_t numLower = MATH_ROUND32((variance - passes * widthLower * widthLower - 4.0f * passes * widthLower -
+                                         3.0f * passes) / (-4.0f * widthLower - 4.0f));
+        for (int32_t i = 0; i < GAUSSIAN_BOX_PASSES; i++) {
+            int32_t width = (i < numLower) ? lower : lower + 2; // 2: the next odd width
+            radii[i] = static_cast<uint16_t>((width - 1) >> 1);
+        }
+    }
+
+    void BoxBlurPasses(uint8_t* image, int32_t width, int32_t height, int32_t stride, float sigma, BlurMode mode)
+    {
+        uint16_t radii[GAUSSIAN_BOX_PASSES];
+        GetGaussianRadii(sigma, radii);
+        for (int32_t i = 0; i < GAUSSIAN_BOX_PASSES; i++) {
+            BoxBlurImage(image, width, height, stride, radii[i], mode);
+        }
+    }
+
+    /**
+     * @brief Average every factor * factor block, clipped at the borders, into a pixel of the small image.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void Downsample(const uint8_t* image, int32_t width, int32_t height, int32_t stride,
+                           uint8_t* small, int32_t smallWidth, int32_t smallHeight, int32_t factor,
+                           int32_t pixelBytes, int32_t blurBytes)
+    {
+        for (int32_t sy = 0; sy < smallHeight; sy++) {
+            int32_t top = sy * factor;
+            int32_t bottom = MATH_MIN(top + factor, height);
+            for (int32_t sx = 0; sx < smallWidth; sx++) {
+                int32_t left = sx * factor;
+                int32_t right = MATH_MIN(left + factor, width);
+                uint32_t sum[FOUR_TIMES] = {0};
+                for (int32_t y = top; y < bottom; y++) {
+                    const uint8_t* src = image + y * stride + left * pixelBytes;
+                    for (int32_t x = left; x < right; x++, src += pixelBytes) {
+                        for (int32_t c = 0; c < blurBytes; c++) {
+                            sum[c] += src[c];
+                        }
+                    }
+                }
+                uint32_t count = static_cast<uint32_t>((bottom - top) * (right - left));
+                uint8_t* dst = small + (sy * smallWidth + sx) * pixelBytes;
+                for (int32_t c = 0; c < pixelBytes; c++) {
+                    // The channels that are not blurred are not used
+                    dst[c] = (c < blurBytes) ? static_cast<uint8_t>((sum[c] + (count >> 1)) / count) : 0;
+                }
             }
-            integral_ = (int32_t*)malloc((width + 1) * (height + 1) * channel * sizeof(int32_t));
-            isGetRGBAIntegral = true;
         }
-        if (channel == FOUR_TIMES) {
-            if (isGetRGBAIntegral) {
-                GetRGBAIntegralImage((uint8_t*)img.PixValuePtr(0, 0), width, height, stride);
+    }
+
+    /**
+     * @brief The position of the pixel center x of the image in the small image, in 1 / 256 pixels,
+     * clamped to the centers of its first and last pixels.
+     * @since 1.0
+     * @version 1.0
+     */
+    static inline int32_t GetSmallPosition(int32_t x, int32_t factor, int32_t smallSize)
+    {
+        // 128: half a pixel, the centers are at x + 0.5 and (x + 0.5) / factor
+        int32_t position = ((2 * x + 1) * 128) / factor - 128;
+        return MATH_MIN(MATH_MAX(position, 0), (smallSize - 1) << 8); // 8: 1 / 256 pixels
+    }
+
+    /**
+     * @brief Scale the small image up into the blurred channels of the image with bilinear interpolation.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void Upsample(const uint8_t* small, int32_t smallWidth, int32_t smallHeight,
+                         uint8_t* image, int32_t width, int32_t height, int32_t stride, int32_t factor,
+                         int32_t pixelBytes, int32_t blurBytes)
+    {
+        const int32_t smallStride = smallWidth * pixelBytes;
+        for (int32_t y = 0; y < height; y++) {
+            int32_t positionY = GetSmallPosition(y, factor, smallHeight);
+            int32_t weightY = positionY & 0xFF;
+            const uint8_t* row0 = small + (positionY >> 8) * smallStride; // 8: 1 / 256 pixels
+            const uint8_t* row1 = (weightY != 0) ? row0 + smallStride : row0;
+            uint8_t* dst = image + y * stride;
+            for (int32_t x = 0; x < width; x++, dst += pixelBytes) {
+                int32_t positionX = GetSmallPosition(x, factor, smallWidth);
+                int32_t weightX = positionX & 0xFF;
+                int32_t index0 = (positionX >> 8) * pixelBytes; // 8: 1 / 256 pixels
+                int32_t index1 = (weightX != 0) ? index0 + pixelBytes : index0;
+                for (int32_t c = 0; c < blurBytes; c++) {
+                    int32_t top = (row0[index0 + c] << 8) + (row0[index1 + c] - row0[index0 + c]) * weightX;
+                    int32_t bottom = (row1[index0 + c] << 8) + (row1[index1 + c] - row1[index0 + c]) * weightX;
+                    int32_t value = (top << 8) + (bottom - top) * weightY;
+                    dst[c] = static_cast<uint8_t>((value + (1 << 15)) >> 16); // 16: two 1 / 256 weights
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Size the line buffer for a row or a strip of columns,
+     * and the reciprocals for every pixel count of a box.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool PrepareBuffers(int32_t width, int32_t height, uint16_t radius, int32_t pixelBytes)
+    {
+        uint32_t lineSize = MATH_MAX(width * pixelBytes, height * BLUR_STRIP_BYTES);
+        if (lineBuffer_.GetSize() < lineSize) {
+            lineBuffer_.Resize(lineSize);
+        }
+        uint32_t maxCount = MATH_MIN(2 * static_cast<uint32_t>(radius) + 1,
+                                     static_cast<uint32_t>(MATH_MAX(width, height)));
+        if (reciprocalCount_ < maxCount) {
+            reciprocal_.Resize(maxCount + 1);
+            reciprocal_[0] = 0;
+            for (uint32_t count = 1; count <= maxCount; count++) {
+                reciprocal_[count] = ((1u << BLUR_RECIPROCAL_SHIFT) + count - 1) / count;
+            }
+            reciprocalCount_ = maxCount;
+        }
+        return lineBuffer_.Data() != nullptr && reciprocal_.Data() != nullptr;
+    }
+
+    static inline uint8_t Average(uint32_t sum, uint32_t reciprocal)
+    {
+        return static_cast<uint8_t>((sum * reciprocal + BLUR_ROUND) >> BLUR_RECIPROCAL_SHIFT);
+    }
+
+    /**
+     * @brief Horizontal pass over a row, reading a copy of it.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <int32_t PIXEL_BYTES, int32_t BLUR_BYTES>
+    void BlurRow(uint8_t* row, int32_t width, int32_t radius)
+    {
+        uint8_t* src = lineBuffer_.Data();
+        if (memcpy_s(src, lineBuffer_.GetSize(), row, width * PIXEL_BYTES) != EOK) {
+            return;
+        }
+        const uint32_t* reciprocal = reciprocal_.Data();
+        uint32_t sum[BLUR_BYTES] = {0};
+        for (int32_t x = 0; x <= MATH_MIN(radius, width - 1); x++) {
+            for (int32_t c = 0; c < BLUR_BYTES; c++) {
+                sum[c] += src[x * PIXEL_BYTES + c];
+            }
+        }
+        for (int32_t x = 0; x < width; x++) {
+            uint32_t count = MATH_MIN(x + radius, width - 1) - MATH_MAX(x - radius, 0) + 1;
+            uint8_t* dst = row + x * PIXEL_BYTES;
+            for (int32_t c = 0; c < BLUR_BYTES; c++) {
+                dst[c] = Average(sum[c], reciprocal[count]);
+            }
+            int32_t in = (x + radius + 1) * PIXEL_BYTES;
+            int32_t out = (x - radius) * PIXEL_BYTES;
+            if (x + radius + 1 < width) {
+                for (int32_t c = 0; c < BLUR_BYTES; c++) {
+                    sum[c] += src[in + c];
+                }
+            }
+            if (out >= 0) {
+                for (int32_t c = 0; c < BLUR_BYTES; c++) {
+                    sum[c] -= src[out + c];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Vertical pass over a strip of at most BLUR_STRIP_BYTES bytes of columns, reading a copy of it.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <int32_t PIXEL_BYTES, int32_t BLUR_BYTES>
+    void BlurStrip(uint8_t* column, int32_t stride, int32_t pixels, int32_t height, int32_t radius)
+    {
+        const int32_t pitch = BLUR_STRIP_BYTES;
+        const int32_t lanes = pixels * PIXEL_BYTES;
+        uint8_t* strip = lineBuffer_.Data();
+        for (int32_t y = 0; y < height; y++) {
+            if (memcpy_s(strip + y * pitch, pitch, column + y * stride, lanes) != EOK) {
+                return;
             }
-#ifndef __ICCARM__
-#pragma omp parallel for
+        }
+#ifdef ARM_NEON_OPT
+        if (lanes == BLUR_STRIP_BYTES) {
+            BlurStripNeon(column, stride, strip, height, radius, BLUR_BYTES < PIXEL_BYTES);
+            return;
+        }
 #endif
-            for (int32_t y = 0; y < height; y++) {
-                int32_t y1 = MATH_MAX(y - radius, 0);
-                int32_t y2 = MATH_MIN(y + radius + 1, height);
-                uint8_t* lineImageHeader = (uint8_t*)img.PixValuePtr(0, 0) + y * stride;
-                uint8_t* linePD = lineImageHeader;
-                int32_t* lineP1 = integral_ + y1 * ((width + 1) << 2);
-                int32_t* lineP2 = integral_ + y2 * ((width + 1) << 2);
-
-                for (int32_t x = 0; x < width; x++) {
-                    int32_t x1 = MATH_MAX(x - radius, 0);
-                    int32_t x2 = MATH_MIN(x + radius + 1, width);
-                    int32_t index1 = x1 << 2;
-                    int32_t index2 = x2 << 2;
-                    int32_t sumB = lineP2[index2 + 0] - lineP1[index2 + 0] -
-                               lineP2[index1 + 0] + lineP1[index1 + 0];
-                    int32_t sumG = lineP2[index2 + 1] - lineP1[index2 + 1] -
-                               lineP2[index1 + 1] + lineP1[index1 + 1];
-                    int32_t sumR = lineP2[index2 + 2] - lineP1[index2 + 2] -
-                               lineP2[index1 + 2] + lineP1[index1 + 2];
-
-                    const int32_t pixelCount = (x2 - x1) * (y2 - y1);
-                    linePD[0] = (sumB + (pixelCount >> 1)) / pixelCount;
-                    linePD[1] = (sumG + (pixelCount >> 1)) / pixelCount;
-                    linePD[2] = (sumR + (pixelCount >> 1)) / pixelCount;
-                    uint8_t* alpha = lineImageHeader + (x << 2);
-                    linePD[3] = alpha[3];
-                    linePD += 4;
+        const uint32_t* reciprocal = reciprocal_.Data();
+        uint32_t sum[BLUR_STRIP_BYTES] = {0};
+        for (int32_t y = 0; y <= MATH_MIN(radius, height - 1); y++) {
+            for (int32_t lane = 0; lane < lanes; lane++) {
+                sum[lane] += strip[y * pitch + lane];
+            }
+        }
+        for (int32_t y = 0; y < height; y++) {
+            uint32_t count = MATH_MIN(y + radius, height - 1) - MATH_MAX(y - radius, 0) + 1;
+            uint8_t* dst = column + y * stride;
+            for (int32_t lane = 0; lane < lanes; lane += PIXEL_BYTES) {
+                for (int32_t c = 0; c < BLUR_BYTES; c++) {
+                    dst[lane + c] = Average(sum[lane + c], reciprocal[count]);
+                }
+            }
+            if (y + radius + 1 < height) {
+                const uint8_t* in = strip + (y + radius + 1) * pitch;
+                for (int32_t lane = 0; lane < lanes; lane++) {
+                    sum[lane] += in[lane];
+                }
+            }
+            if (y - radius >= 0) {
+                const uint8_t* out = strip + (y - radius) * pitch;
+                for (int32_t lane = 0; lane < lanes; lane++) {
+                    sum[lane] -= out[lane];
                 }
             }
         }
     }
-private:
-    void GetRGBAIntegralImage(uint8_t* src, uint16_t width, uint16_t height, uint16_t stride)
-    {
-        int32_t channel = FOUR_TIMES;
-        if (integral_ != nullptr && ((imageWidth_ * imageHeight_) != (width * height))) {
-            int32_t integralSize = (width + 1) * channel * sizeof(int32_t);
-            memset_s(integral_, integralSize, 0, integralSize);
-        }
-        for (int y = 0; y < height; y++) {
-            uint8_t* linePS = src + y * stride;
-            //	last position
-            int32_t* linePL = integral_ + y * (width + 1) * channel + channel;
-            //	curretn position£¬waring the first column of every line row is zero
-            int32_t* linePD = integral_ + (y + 1) * (width + 1) * channel + channel;
-            //	the first column is 0
-            linePD[-4] = 0;
-            linePD[-3] = 0;
-            linePD[-2] = 0;
-            linePD[-1] = 0;
-            for (int x = 0, sumB = 0, sumG = 0, sumR = 0, sumA = 0; x < width; x++) {
-                sumB += linePS[0];
-                sumG += linePS[1];
-                sumR += linePS[2];
-                sumA += linePS[3];
-                linePD[0] = linePL[0] + sumB;
-                linePD[1] = linePL[1] + sumG;
-                linePD[2] = linePL[2] + sumR;
-                linePD[3] = linePL[3] + sumA;
-                linePS += channel;
-                linePL += channel;
-                linePD += channel;
+
+#ifdef ARM_NEON_OPT
+    static inline void NeonAddRow(uint32x4_t* sum, const uint8_t* row)
+    {
+        uint8x16_t value = vld1q_u8(row);
+        uint16x8_t low = vmovl_u8(vget_low_u8(value));
+        uint16x8_t high = vmovl_u8(vget_high_u8(value));
+        sum[0] = vaddw_u16(sum[0], vget_low_u16(low));
+        sum[1] = vaddw_u16(sum[1], vget_high_u16(low));
+        sum[2] = vaddw_u16(sum[2], vget_low_u16(high)); // 2: third quarter of the lanes
+        sum[3] = vaddw_u16(sum[3], vget_high_u16(high)); // 3: last quarter of the lanes
+    }
+
+    static inline void NeonSubRow(uint32x4_t* sum, const uint8_t* row)
+    {
+        uint8x16_t value = vld1q_u8(row);
+        uint16x8_t low = vmovl_u8(vget_low_u8(value));
+        uint16x8_t high = vmovl_u8(vget_high_u8(value));
+        sum[0] = vsubw_u16(sum[0], vget_low_u16(low));
+        sum[1] = vsubw_u16(sum[1], vget_high_u16(low));
+        sum[2] = vsubw_u16(sum[2], vget_low_u16(high)); // 2: third quarter of the lanes
+        sum[3] = vsubw_u16(sum[3], vget_high_u16(high)); // 3: last quarter of the lanes
+    }
+
+    static inline uint16x4_t NeonAverage(uint32x4_t sum, uint32_t reciprocal)
+    {
+        return vmovn_u32(vshrq_n_u32(vmlaq_n_u32(vdupq_n_u32(BLUR_ROUND), sum, reciprocal), BLUR_RECIPROCAL_SHIFT));
+    }
+
+    /**
+     * @brief The vertical pass of a full strip, every 16 bytes of a row summed in four 32 bit vectors.
+     * With keepAlpha, the alpha of the BGRA pixels is taken back from the source.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlurStripNeon(uint8_t* column, int32_t stride, const uint8_t* strip, int32_t height, int32_t radius,
+                       bool keepAlpha)
+    {
+        const int32_t pitch = BLUR_STRIP_BYTES;
+        const int32_t vectors = pitch / NEON_BLUR_BYTES;
+        const uint32_t* reciprocal = reciprocal_.Data();
+        const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(keepAlpha ? 0xFF000000 : 0));
+        uint32x4_t sum[BLUR_STRIP_BYTES / FOUR_TIMES];
+        for (int32_t i = 0; i < BLUR_STRIP_BYTES / FOUR_TIMES; i++) {
+            sum[i] = vdupq_n_u32(0);
+        }
+        for (int32_t y = 0; y <= MATH_MIN(radius, height - 1); y++) {
+            for (int32_t i = 0; i < vectors; i++) {
+                NeonAddRow(sum + i * FOUR_TIMES, strip + y * pitch + i * NEON_BLUR_BYTES);
+            }
+        }
+        for (int32_t y = 0; y < height; y++) {
+            uint32_t count = MATH_MIN(y + radius, height - 1) - MATH_MAX(y - radius, 0) + 1;
+            for (int32_t i = 0; i < vectors; i++) {
+                const uint32x4_t* vectorSum = sum + i * FOUR_TIMES;
+                uint16x8_t low = vcombine_u16(NeonAverage(vectorSum[0], reciprocal[count]),
+                                              NeonAverage(vectorSum[1], reciprocal[count]));
+                uint16x8_t high = vcombine_u16(NeonAverage(vectorSum[2], reciprocal[count]), // 2: third quarter
+                                               NeonAverage(vectorSum[3], reciprocal[count])); // 3: last quarter
+                uint8x16_t average = vcombine_u8(vmovn_u16(low), vmovn_u16(high));
+                uint8x16_t source = vld1q_u8(strip + y * pitch + i * NEON_BLUR_BYTES);
+                vst1q_u8(column + y * stride + i * NEON_BLUR_BYTES, vbslq_u8(alphaMask, source, average));
+            }
+            for (int32_t i = 0; i < vectors; i++) {
+                if (y + radius + 1 < height) {
+                    NeonAddRow(sum + i * FOUR_TIMES, strip + (y + radius + 1) * pitch + i * NEON_BLUR_BYTES);
+                }
+                if (y - radius >= 0) {
+                    NeonSubRow(sum + i * FOUR_TIMES, strip + (y - radius) * pitch + i * NEON_BLUR_BYTES);
+                }
             }
         }
     }
+#endif
 
-    int32_t* integral_;
-    int32_t imageWidth_;
-    int32_t imageHeight_;
+    GeometryPlainDataArray<uint8_t> lineBuffer_;
+    GeometryPlainDataArray<uint32_t> reciprocal_;
+    GeometryPlainDataArray<uint8_t> smallImage_;
+    uint32_t reciprocalCount_;
 #endif
 };
 } // namespace OHOS
@@ -24,6 +24,7 @@
 #define GRAPHIC_LITE_RASTERIZER_CELLS_ANTIALIAS_H
 
 #include "gfx_utils/diagram/common/common_math.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
 #include "gfx_utils/vector.h"
 
 namespace OHOS {
@@ -74,6 +75,26 @@ class RasterizerCellsAntiAlias {
         DX_LIMIT = CONSTITUTION << POLY_SUBPIXEL_SHIFT
     };
 
+    /**
+     * @brief Rows holding at least RADIX_SORT_THRESHOLD cells are sorted by radix,
+     * smaller rows keep using the quick sort.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum CellSortScale {
+        RADIX_SORT_THRESHOLD = 64
+    };
+
+    /**
+     * @brief The dense accumulation box is limited to DENSE_BOX_LIMIT pixels,
+     * a path needing a larger box continues in the cell list.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum DenseBoxScale {
+        DENSE_BOX_LIMIT = 1 << 22
+    };
+
 public:
     ~RasterizerCellsAntiAlias();
 
@@ -91,6 +112,14 @@ public:
      * @version 1.0
      */
     void Reset();
+
+    /**
+     * @brief The sort buffers and cell blocks survive Reset() and are reused by the next path.
+     * ShrinkToFit releases the ones the current path does not need, e.g. after a very large path.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ShrinkToFit();
     void SetStyle(const CellBuildAntiAlias& styleCell);
 
     /**
@@ -157,7 +186,18 @@ public:
      */
     const CellBuildAntiAlias * const *GetScanlineCells(uint32_t yLevel)
     {
-        return sortedCells_ + sortedY_[yLevel - minY_].start;
+        return sortedCells_.Data() + sortedY_[yLevel - minY_].start;
+    }
+
+    /**
+     * @brief In the process of rasterization, it is calculated according to the coordinate height of Y
+     * The first address of the cells sorted by value, only valid when GetSortByValue() is true.
+     * @since 1.0
+     * @version 1.0
+     */
+    const CellBuildAntiAlias* GetScanlineValueCells(uint32_t yLevel)
+    {
+        return sortedValueCells_.Data() + sortedY_[yLevel - minY_].start;
     }
 
     bool GetSorted() const
@@ -165,6 +205,117 @@ public:
         return sorted_;
     }
 
+    /**
+     * @brief Sets whether SortAllCells copies the cells into a contiguous array sorted by value
+     * instead of building an array of pointers into the cell blocks. Takes effect from the next sort.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetSortByValue(bool byValue)
+    {
+        sortByValue_ = byValue;
+    }
+
+    bool GetSortByValue() const
+    {
+        return sortByValue_;
+    }
+
+    /**
+     * @brief The cell budget in blocks, 0 means no budget. Cells beyond it are dropped and counted,
+     * so that the rasterizer can build the path again in bands.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellBlockLimit(uint32_t cellBlockLimit)
+    {
+        cellBlockLimit_ = cellBlockLimit;
+    }
+
+    uint32_t GetCellBlockLimit() const
+    {
+        return cellBlockLimit_;
+    }
+
+    uint32_t GetCellBudget() const
+    {
+        return cellBlockLimit_ << CELL_BLOCK_SHIFT;
+    }
+
+    /**
+     * @brief Keep only the cells of the rows from minRow to maxRow, until the next Reset.
+     * The lines are still walked from their ends, so the cells match the same rows of the whole path.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetRowRange(int32_t minRow, int32_t maxRow)
+    {
+        minRow_ = minRow;
+        maxRow_ = maxRow;
+    }
+
+    int32_t GetMinRow() const
+    {
+        return minRow_;
+    }
+
+    int32_t GetMaxRow() const
+    {
+        return maxRow_;
+    }
+
+    /**
+     * @brief The number of cells dropped beyond the budget since the last Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetDroppedCells() const
+    {
+        return droppedCells_;
+    }
+
+    /**
+     * @brief Accumulate the cover and area of the cells directly into dense rows over the bounding box
+     * of the path instead of storing and sorting the cells, should be set while the cells are reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetDense(bool dense)
+    {
+        dense_ = dense;
+    }
+
+    bool GetDense() const
+    {
+        return dense_;
+    }
+
+    /**
+     * @brief Whether the cells of the current path are in the dense rows, that is dense mode is set
+     * and the path has not outgrown the dense box limit.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsAccumulatingDense() const
+    {
+        return dense_ && !denseSpilled_;
+    }
+
+    /**
+     * @brief The accumulated cover deltas and areas of a row in dense mode, starting at GetMinX().
+     * @since 1.0
+     * @version 1.0
+     */
+    const int32_t* GetDenseCoverRow(int32_t yLevel) const
+    {
+        return denseCover_ + (yLevel - denseMinY_) * static_cast<int32_t>(denseWidth_) + (minX_ - denseMinX_);
+    }
+
+    const int32_t* GetDenseAreaRow(int32_t yLevel) const
+    {
+        return denseArea_ + (yLevel - denseMinY_) * static_cast<int32_t>(denseWidth_) + (minX_ - denseMinX_);
+    }
+
 private:
     RasterizerCellsAntiAlias(const CellBuildAntiAlias&);
     const CellBuildAntiAlias& operator=(const CellBuildAntiAlias&);
@@ -184,6 +335,10 @@ private:
      * @version 1.0
      */
     void AddCurrentCell();
+    void AddDenseCell();
+    void ExpandDenseBox(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+    void SpillDenseBox();
+    void FreeDenseBox();
 
     /**
      * @brief n the rasterization process, the horizontal direction is
@@ -200,7 +355,11 @@ private:
 
     void RenderObliqueLine(int64_t& dx, int64_t& dy, int32_t& first,
                            int32_t& increase, int32_t& xFrom, int64_t& deltaxMask,
-                           int32_t& ey1, int32_t& ey2, int32_t& delta);
+                           int32_t& ey1, int32_t& ey2, int32_t& delta, int32_t modDyMask);
+
+    void FreeBlocks(uint32_t keepBlocks);
+    void SortCellsByPointer(uint32_t maxRowCells);
+    void SortCellsByValue(uint32_t maxRowCells);
 
     /**
      * @brief Allocate array space for cells during rasterization.
@@ -214,18 +373,34 @@ private:
     uint32_t maxBlocks_;
     uint32_t currBlock_;
     uint32_t numCells_;
+    uint32_t droppedCells_;
     uint32_t cellBlockLimit_;
     CellBuildAntiAlias** cells_;
     CellBuildAntiAlias* currCellPtr_;
-    CellBuildAntiAlias** sortedCells_;
-    SortedYLevel* sortedY_;
+    GeometryPlainDataArray<CellBuildAntiAlias*> sortedCells_;
+    GeometryPlainDataArray<CellBuildAntiAlias> sortedValueCells_;
+    GeometryPlainDataArray<SortedYLevel> sortedY_;
+    GeometryPlainDataArray<CellBuildAntiAlias*> sortTemp_;
+    GeometryPlainDataArray<CellBuildAntiAlias> sortValueTemp_;
+    int32_t* denseCover_;
+    int32_t* denseArea_;
+    uint32_t denseSize_;
+    uint32_t denseWidth_;
+    uint32_t denseHeight_;
+    int32_t denseMinX_;
+    int32_t denseMinY_;
     CellBuildAntiAlias currCell_;
     CellBuildAntiAlias styleCell_;
     int32_t minX_;
     int32_t minY_;
     int32_t maxX_;
     int32_t maxY_;
+    int32_t minRow_;
+    int32_t maxRow_;
     bool sorted_;
+    bool sortByValue_;
+    bool dense_;
+    bool denseSpilled_;
 };
 
 class ScanlineHitRegionMeasure {
@@ -280,6 +455,23 @@ void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, C
  */
 void QsortCells(CellBuildAntiAlias** start, uint32_t num);
 
+/**
+ * @brief In the rasterization process, the cells of a crowded row are sorted by
+ * LSD radix on x. T is CellBuildAntiAlias* to sort the pointers or CellBuildAntiAlias to sort the cells,
+ * temp must hold at least num of them.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class T>
+void RadixSortCells(T* start, uint32_t num, T* temp);
+
+/**
+ * @brief In the rasterization process, the cells of a small row are sorted by value with insertion.
+ * @since 1.0
+ * @version 1.0
+ */
+void InsertSortCells(CellBuildAntiAlias* start, uint32_t num);
+
 void QsortCellsFor(CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex,
                    CellBuildAntiAlias*** limit, CellBuildAntiAlias*** base);
 } // namespace OHOS
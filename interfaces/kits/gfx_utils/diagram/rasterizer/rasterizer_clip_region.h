@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_clip_region.h
+ * @brief Defines Clipping of the swept scanlines to a region of several rectangles
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_CLIP_REGION_H
+#define GRAPHIC_LITE_RASTERIZER_CLIP_REGION_H
+
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/rect.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerClipRegion
+ * @brief Clips a path to the union of several rectangles, e.g. the dirty rectangles of a frame,
+ * rasterizing it once instead of once per rectangle.
+ * The rectangles are kept as a y-banded region: rows of equal rectangles form a band, holding
+ * the sorted and merged x intervals covered in its rows.
+ * The rasterizer is clipped to the bounds of the region, so no cell is built outside of them,
+ * and every swept scanline is then cut to the intervals of its band:
+ *     region.SetRects(dirtyRects, numDirtyRects);
+ *     region.ApplyClipBox(ras);
+ *     ras.AddPath(path);
+ *     if (region.RewindScanlines(ras)) {
+ *         sl.Reset(ras.GetMinX(), ras.GetMaxX());
+ *         while (region.SweepScanline(ras, sl)) { render sl }
+ *     }
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerClipRegion {
+public:
+    RasterizerClipRegion() : numBands_(0), curBand_(0), minX_(0), minY_(0), maxX_(0), maxY_(0) {}
+
+    void Reset()
+    {
+        numBands_ = 0;
+        curBand_ = 0;
+    }
+
+    /**
+     * @brief Set the region to the union of the rectangles, whose right and bottom are inclusive.
+     * Overlapping rectangles are merged, empty ones are skipped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetRects(const Rect32* rects, uint32_t numRects);
+
+    bool IsEmpty() const
+    {
+        return numBands_ == 0;
+    }
+
+    uint32_t GetNumBands() const
+    {
+        return numBands_;
+    }
+
+    /**
+     * @brief Whether the pixel is inside the region.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Contains(int32_t x, int32_t y);
+
+    /**
+     * @brief Clip the rasterizer to the bounds of the region, before its path is added.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Rasterizer>
+    void ApplyClipBox(Rasterizer& ras) const
+    {
+        if (numBands_ == 0) {
+            ras.ClipBox(0, 0, 0, 0);
+            return;
+        }
+        ras.ClipBox(minX_, minY_, maxX_ + 1, maxY_ + 1);
+    }
+
+    /**
+     * @brief Rewind the scanlines of the rasterizer, to be swept through SweepScanline.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Rasterizer>
+    bool RewindScanlines(Rasterizer& ras)
+    {
+        curBand_ = 0;
+        if (numBands_ == 0 || !ras.RewindScanlines()) {
+            return false;
+        }
+        rowScanline_.Reset(ras.GetMinX(), ras.GetMaxX());
+        return true;
+    }
+
+    /**
+     * @brief Sweep the next scanline of the rasterizer having any span inside the region,
+     * with its spans cut to the region. Solid spans stay solid.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Rasterizer, class Scanline>
+    bool SweepScanline(Rasterizer& ras, Scanline& sl)
+    {
+        while (ras.SweepScanline(rowScanline_)) {
+            int32_t y = rowScanline_.GetYLevel();
+            const ClipBand* band = FindBand(y);
+            if (band == nullptr) {
+                continue;
+            }
+            sl.ResetSpans();
+            ClipRow(*band, sl);
+            if (sl.NumSpans() != 0) {
+                sl.Finalize(y);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    RasterizerClipRegion(const RasterizerClipRegion&);
+    const RasterizerClipRegion& operator=(const RasterizerClipRegion&);
+
+    /**
+     * @brief The pixels from left to right inclusive.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct ClipInterval {
+        int32_t left;
+        int32_t right;
+    };
+
+    /**
+     * @brief The rows from top to bottom inclusive and their intervals.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct ClipBand {
+        int32_t top;
+        int32_t bottom;
+        uint32_t firstInterval;
+        uint32_t numIntervals;
+    };
+
+    const ClipBand* FindBand(int32_t y);
+    uint32_t CollectIntervals(const Rect32* rects, uint32_t numRects, int32_t top, int32_t bottom,
+                              ClipInterval* intervals) const;
+
+    template <class Scanline>
+    void ClipRow(const ClipBand& band, Scanline& sl) const
+    {
+        const ClipInterval* intervals = intervals_.Data() + band.firstInterval;
+        uint32_t first = 0;
+        GeometryScanlinePacked32::ConstIterator span = rowScanline_.Begin();
+        for (uint32_t i = rowScanline_.NumSpans(); i > 0; i--, span++) {
+            bool solid = span->spanLength < 0;
+            int32_t spanLeft = span->x;
+            int32_t spanRight = span->x + (solid ? -span->spanLength : span->spanLength) - 1;
+            while (first < band.numIntervals && intervals[first].right < spanLeft) {
+                first++;
+            }
+            for (uint32_t k = first; k < band.numIntervals && intervals[k].left <= spanRight; k++) {
+                int32_t left = MATH_MAX(spanLeft, intervals[k].left);
+                int32_t right = MATH_MIN(spanRight, intervals[k].right);
+                uint32_t length = static_cast<uint32_t>(right - left + 1);
+                if (solid) {
+                    sl.AddSpan(left, length, *span->covers);
+                } else {
+                    sl.AddCells(left, length, span->covers + (left - spanLeft));
+                }
+            }
+        }
+    }
+
+    GeometryPlainDataArray<ClipBand> bands_;
+    GeometryPlainDataArray<ClipInterval> intervals_;
+    GeometryPlainDataArray<int32_t> edges_;
+    GeometryScanlinePacked32 rowScanline_;
+    uint32_t numBands_;
+    uint32_t curBand_;
+    int32_t minX_;
+    int32_t minY_;
+    int32_t maxX_;
+    int32_t maxY_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_gamma.h
+ * @brief Defines the coverage curves for RasterizerScanlineAntialias::Gamma
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_GAMMA_H
+#define GRAPHIC_LITE_RASTERIZER_GAMMA_H
+
+#include <cmath>
+
+namespace OHOS {
+/**
+ * Every curve maps a coverage in [0, 1] to a coverage in [0, 1],
+ * any callable with the same signature can be used as a custom curve.
+ */
+
+/**
+ * @brief The identity curve, the default of the rasterizer.
+ * @since 1.0
+ * @version 1.0
+ */
+struct GammaNone {
+    float operator()(float x) const
+    {
+        return x;
+    }
+};
+
+/**
+ * @brief x ^ gamma, a gamma below 1 makes the edges heavier, above 1 lighter.
+ * @since 1.0
+ * @version 1.0
+ */
+class GammaPower {
+public:
+    GammaPower() : gamma_(1.0f) {}
+    explicit GammaPower(float gamma) : gamma_(gamma) {}
+
+    float operator()(float x) const
+    {
+        return std::pow(x, gamma_);
+    }
+
+private:
+    float gamma_;
+};
+
+/**
+ * @brief Coverage below the threshold is dropped and the rest is fully covered, i.e. aliased edges.
+ * @since 1.0
+ * @version 1.0
+ */
+class GammaThreshold {
+public:
+    GammaThreshold() : threshold_(0.5f) {}
+    explicit GammaThreshold(float threshold) : threshold_(threshold) {}
+
+    float operator()(float x) const
+    {
+        return (x < threshold_) ? 0.0f : 1.0f;
+    }
+
+private:
+    float threshold_;
+};
+
+/**
+ * @brief Coverage below start is dropped, above end is fully covered, and stretched linearly in between.
+ * @since 1.0
+ * @version 1.0
+ */
+class GammaLinear {
+public:
+    GammaLinear() : start_(0.0f), end_(1.0f) {}
+    GammaLinear(float start, float end) : start_(start), end_(end) {}
+
+    float operator()(float x) const
+    {
+        if (x < start_) {
+            return 0.0f;
+        }
+        if (x > end_) {
+            return 1.0f;
+        }
+        return (x - start_) / (end_ - start_);
+    }
+
+private:
+    float start_;
+    float end_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_hit_test.h
+ * @brief Defines Hit testing of a path by its winding number
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_HIT_TEST_H
+#define GRAPHIC_LITE_RASTERIZER_HIT_TEST_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerHitTest
+ * @brief Tests whether points are inside a path without rasterizing it.
+ * AddPath keeps the flattened edges of the path, every subpath implicitly closed as when it is filled,
+ * and the first test indexes them by rows. A test then only visits the edges of the row of the point
+ * and counts the winding number of a ray to its right, with the non-zero or the even-odd rule.
+ * Keep one instance per shape to reuse the edges across touches.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerHitTest {
+public:
+    /**
+     * @brief The edges are indexed by at most HIT_MAX_ROWS rows of equal height,
+     * and the edge array grows by EDGE_BLOCK_POOL edges at least.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum HitTestScale {
+        HIT_MAX_ROWS = 256,
+        EDGE_BLOCK_POOL = 256
+    };
+
+    RasterizerHitTest();
+
+    ~RasterizerHitTest();
+
+    /**
+     * @brief Drop the edges, e.g. when the shape changes.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    void SetFillingRule(FillingRule fillingRule)
+    {
+        fillingRule_ = fillingRule;
+    }
+
+    FillingRule GetFillingRule() const
+    {
+        return fillingRule_;
+    }
+
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    /**
+     * @brief Add the flattened edges of a path, in the same coordinates as the points to test.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            AddVertex(x, y, cmd);
+        }
+        ClosePolygon();
+    }
+
+    /**
+     * @brief The number of times the edges wind around the point, signed by their direction.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetWindingNumber(float x, float y);
+
+    /**
+     * @brief Whether the point is inside the path under the filling rule.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool HitTest(float x, float y)
+    {
+        int32_t winding = GetWindingNumber(x, y);
+        return (fillingRule_ == FILL_EVEN_ODD) ? ((winding & 1) != 0) : (winding != 0);
+    }
+
+    uint32_t GetNumEdges() const
+    {
+        return numEdges_;
+    }
+
+private:
+    RasterizerHitTest(const RasterizerHitTest&);
+    const RasterizerHitTest& operator=(const RasterizerHitTest&);
+
+    /**
+     * @brief An edge from its top to its bottom, x is at the top and dir is +1 downwards, -1 upwards.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct HitEdge {
+        float x;
+        float top;
+        float bottom;
+        float slope;
+        int32_t dir;
+    };
+
+    void AddEdge(float x1, float y1, float x2, float y2);
+    void IndexRows();
+    uint32_t GetRow(float y) const;
+
+    HitEdge* edges_;
+    uint32_t numEdges_;
+    uint32_t maxEdges_;
+    GeometryPlainDataArray<uint32_t> rowStart_;
+    GeometryPlainDataArray<uint32_t> rowEdges_;
+    uint32_t numRows_;
+    float rowScale_;
+    float startX_;
+    float startY_;
+    float lastX_;
+    float lastY_;
+    float minX_;
+    float minY_;
+    float maxX_;
+    float maxY_;
+    FillingRule fillingRule_;
+    bool open_;
+    bool indexed_;
+};
+} // namespace OHOS
+#endif
@@ -24,8 +24,10 @@
 #define GRAPHIC_LITE_RASTERIZER_SCANLINE_ANTIALIAS_H
 
 #include "rasterizer_cells_antialias.h"
+#include "rasterizer_gamma.h"
 #include "rasterizer_scanline_clip.h"
 #include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
 namespace OHOS {
 /**
  * @class RasterizerScanlineAntiAlias
@@ -59,28 +61,75 @@ public:
         AA_MASK2 = AA_SCALE2 - 1
     };
 
+    /**
+     * @brief A scanline with at least DENSE_ROW_MIN_CELLS cells, spread over no more than
+     * DENSE_ROW_RATIO pixels per cell, is swept through a dense accumulation row.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum DenseRowScale {
+        DENSE_ROW_MIN_CELLS = 16,
+        DENSE_ROW_RATIO = 4
+    };
+
+    /**
+     * @brief A run of at least SOLID_RUN_MIN_PIXELS pixels of the same alpha in a dense row
+     * is added as one solid span, which a packed scanline keeps without a cover per pixel.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum SolidRunScale {
+        SOLID_RUN_MIN_PIXELS = 4
+    };
+
+    /**
+     * @brief PreferDenseAccumulate picks dense accumulation for a path whose bounding box has no more than
+     * DENSE_MAX_PIXELS pixels and no more than DENSE_PIXELS_PER_EDGE pixels per edge.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum DenseAccumulateScale {
+        DENSE_MAX_PIXELS = 1 << 16,
+        DENSE_PIXELS_PER_EDGE = 64
+    };
+
     /**
      * Construction of rasterized scanline antialiasing constructor
      * @brief It mainly includes the allocation quota of cell block and cutter
      * Filling rules, automatic closing, starting position, etc.
+     * cell_block_limit is the cell budget in blocks of 32 cells, see SetCellBudget.
      * @since 1.0
      * @version 1.0
      */
     RasterizerScanlineAntialias(uint32_t cell_block_limit = (1 << (AA_SHIFT + 2)))
         : outline_(cell_block_limit),
           clipper_(),
+          vertices_(nullptr),
+          numVertices_(0),
+          maxVertices_(0),
+          peakCells_(0),
           fillingRule_(FILL_NON_ZERO),
           autoClose_(true),
+          banded_(false),
+          recording_(false),
           startX_(0),
           startY_(0),
           status_(STATUS_INITIAL),
-          scanY_(0)
+          scanY_(0),
+          bandTop_(0),
+          bandRows_(0),
+          pathMinX_(0),
+          pathMinY_(0),
+          pathMaxX_(0),
+          pathMaxY_(0)
     {
         for (int32_t coverIndex = 0; coverIndex < AA_SCALE; coverIndex++) {
             gammar_[coverIndex] = coverIndex;
         }
     }
 
+    ~RasterizerScanlineAntialias();
+
     /**
      * @brief Reset the cell array for building contour lines,
      * Reset the scan line status value, etc.
@@ -89,6 +138,20 @@ public:
      */
     void Reset();
 
+    /**
+     * @brief Release the cell blocks and sort buffers kept across Reset() that the current path does not use,
+     * e.g. to trim memory after an unusually large path.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ShrinkToFit()
+    {
+        outline_.ShrinkToFit();
+        accumCover_.Resize(0);
+        accumArea_.Resize(0);
+        accumAlpha_.Resize(0);
+    }
+
     /**
      * @brief Reset the clipping range and clipping flag of the clipper.
      * @since 1.0
@@ -102,6 +165,159 @@ public:
         autoClose_ = flag;
     }
 
+    /**
+     * @brief Set the cell budget in blocks of 32 cells, 0 means no budget.
+     * With a budget the vertices of the path are recorded as well, 12 bytes per vertex. A path that needs
+     * more cells is rasterized again band by band on RewindScanlines, each band within the budget,
+     * instead of losing the cells beyond it. Like ClipBox, setting the budget resets the rasterizer.
+     * The budget of the constructor records nothing, so a path over it loses the cells beyond it.
+     * Without a budget nothing is recorded and no cell is dropped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellBudget(uint32_t cellBlockLimit)
+    {
+        Reset();
+        outline_.SetCellBlockLimit(cellBlockLimit);
+        recording_ = cellBlockLimit != 0;
+    }
+
+    /**
+     * @brief Build only the rows from top to bottom of the next path, e.g. one band of it.
+     * Unlike a clip box the lines are not cut, so the rows match the same rows of the whole path.
+     * Reset clears the limit.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetBandRows(int32_t top, int32_t bottom)
+    {
+        outline_.SetRowRange(top, bottom);
+    }
+
+    /**
+     * @brief The most cells held at once since construction, to tune the cell budget.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetPeakCells() const
+    {
+        return peakCells_;
+    }
+
+    /**
+     * @brief Whether the current path exceeded the cell budget and is swept band by band.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsBanded() const
+    {
+        return banded_;
+    }
+
+    /**
+     * @brief Precompute the gamma table from a coverage curve, such as GammaPower, GammaLinear,
+     * GammaThreshold or any callable mapping a coverage in [0, 1] to [0, 1].
+     * The curve is applied by the table lookup every alpha already goes through,
+     * so it adds no cost per pixel.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class GammaFunction>
+    void Gamma(const GammaFunction& gammaFunction)
+    {
+        for (int32_t coverIndex = 0; coverIndex < AA_SCALE; coverIndex++) {
+            float cover = gammaFunction(static_cast<float>(coverIndex) / AA_MASK) * AA_MASK;
+            cover = MATH_MIN(MATH_MAX(cover, 0.0f), static_cast<float>(AA_MASK));
+            gammar_[coverIndex] = MATH_UROUND(cover);
+        }
+    }
+
+    uint32_t ApplyGamma(uint32_t cover) const
+    {
+        return gammar_[cover];
+    }
+
+    /**
+     * @brief Sort the cells by value into one contiguous array instead of an array of pointers,
+     * so that SweepScanline reads every scanline as a linear stream.
+     * Suitable for large paths whose cells are scattered across many cell blocks.
+     * Like ClipBox, switching the mode resets the rasterizer.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SortByValue(bool flag)
+    {
+        Reset();
+        outline_.SetSortByValue(flag);
+    }
+
+    /**
+     * @brief Accumulate the cover and area of the path directly into a dense buffer over its bounding box
+     * instead of building and sorting the cell list, like the accumulation buffer of a font rasterizer.
+     * Suitable for small or complex shapes such as glyphs, see PreferDenseAccumulate.
+     * Like ClipBox, switching the mode resets the rasterizer.
+     * @since 1.0
+     * @version 1.0
+     */
+    void AccumulateDense(bool flag)
+    {
+        Reset();
+        outline_.SetDense(flag);
+    }
+
+    /**
+     * @brief Whether dense accumulation is cheaper than the cell list for a bounding box of
+     * width x height pixels crossed by numEdges edges.
+     * @since 1.0
+     * @version 1.0
+     */
+    static bool PreferDenseAccumulate(int32_t width, int32_t height, uint32_t numEdges)
+    {
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        uint64_t pixels = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+        return pixels <= DENSE_MAX_PIXELS && pixels <= static_cast<uint64_t>(numEdges) * DENSE_PIXELS_PER_EDGE;
+    }
+
+    /**
+     * @brief Measure the bounding box and the edges of a vertex source to choose AccumulateDense for it.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <typename VertexSource>
+    static bool PreferDenseAccumulate(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+        float minX = 0;
+        float minY = 0;
+        float maxX = 0;
+        float maxY = 0;
+        uint32_t numEdges = 0;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            if (!IsVertex(cmd)) {
+                continue;
+            }
+            if (numEdges == 0) {
+                minX = x;
+                maxX = x;
+                minY = y;
+                maxY = y;
+            }
+            minX = MATH_MIN(minX, x);
+            minY = MATH_MIN(minY, y);
+            maxX = MATH_MAX(maxX, x);
+            maxY = MATH_MAX(maxY, y);
+            ++numEdges;
+        }
+        return PreferDenseAccumulate(static_cast<int32_t>(maxX - minX) + 1,
+                                     static_cast<int32_t>(maxY - minY) + 1, numEdges);
+    }
+
     /**
      * @brief Set the starting position of the element according to the of 1 / 256 pixel unit.
      * @since 1.0
@@ -149,7 +365,7 @@ public:
 
         uint32_t cmd;
         vs.Rewind(pathId);
-        if (outline_.GetSorted()) {
+        if (IsPathSwept()) {
             Reset();
         }
         while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
@@ -157,6 +373,39 @@ public:
         }
     }
 
+    /**
+     * @brief Whether a path whose control points lie within the bounds, in pixels, can cover the clip box.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsPathVisible(float x1, float y1, float x2, float y2) const
+    {
+        return clipper_.IsBoxVisible(RasterDepictInt::UpScale(MATH_MIN(x1, x2)),
+                                     RasterDepictInt::UpScale(MATH_MIN(y1, y2)),
+                                     RasterDepictInt::UpScale(MATH_MAX(x1, x2)),
+                                     RasterDepictInt::UpScale(MATH_MAX(y1, y2)));
+    }
+
+    /**
+     * @brief Add a path with known control point bounds, e.g. the bounding rect of a shape.
+     * A path outside of the clip box is skipped before any vertex is generated or clipped.
+     * @return Whether the path was added.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <typename VertexSource>
+    bool AddPathCulled(VertexSource& vs, float x1, float y1, float x2, float y2, uint32_t pathId = 0)
+    {
+        if (IsPathSwept()) {
+            Reset();
+        }
+        if (!IsPathVisible(x1, y1, x2, y2)) {
+            return false;
+        }
+        AddPath(vs, pathId);
+        return true;
+    }
+
     /**
      * @brief The range boundary value of the contour line.
      * @since 1.0
@@ -164,19 +413,19 @@ public:
      */
     int32_t GetMinX() const
     {
-        return outline_.GetMinX();
+        return banded_ ? pathMinX_ : outline_.GetMinX();
     }
     int32_t GetMinY() const
     {
-        return outline_.GetMinY();
+        return banded_ ? pathMinY_ : outline_.GetMinY();
     }
     int32_t GetMaxX() const
     {
-        return outline_.GetMaxX();
+        return banded_ ? pathMaxX_ : outline_.GetMaxX();
     }
     int32_t GetMaxY() const
     {
-        return outline_.GetMaxY();
+        return banded_ ? pathMaxY_ : outline_.GetMaxY();
     }
 
     /**
@@ -200,25 +449,87 @@ public:
      * The color information is obtained successfully,
      * and then the alpha information of color is calculated by gamma function
      * Fill in the new scanline and have subsequent render.
+     * The scanline is a GeometryScanline or a GeometryScanlinePacked, or their 32 bit variants.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief Sweep only the row y, visiting the rows from top to bottom.
+     * @return Whether the row has any span, unlike SweepScanline empty rows are not skipped.
      * @since 1.0
      * @version 1.0
      */
-    bool SweepScanline(GeometryScanline& sl);
+    template <class Scanline>
+    bool SweepScanlineRow(Scanline& sl, int32_t y);
 
 private:
     // Disable copying
     RasterizerScanlineAntialias(const RasterizerScanlineAntialias&);
     const RasterizerScanlineAntialias& operator=(const RasterizerScanlineAntialias&);
 
+    struct RecordedVertex {
+        int32_t x;
+        int32_t y;
+        uint32_t cmd;
+    };
+
+    enum VertexScale {
+        VERTEX_BLOCK_POOL = 256
+    };
+
+    /**
+     * @brief Whether the current path has been swept, so that the next path starts with a Reset.
+     * A banded path counts as swept even when the outline holds no cells after its last band.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsPathSwept() const
+    {
+        return outline_.GetSorted() || banded_;
+    }
+
+    void MoveToPoint(int32_t x, int32_t y);
+    void LineToPoint(int32_t x, int32_t y);
+    void CloseCurrentPolygon();
+    void RecordVertex(int32_t x, int32_t y, uint32_t cmd);
+    void StartBands();
+    void RasterizeBand(int32_t top, int32_t rows);
+    bool RasterizeNextBand();
+    void UpdatePeakCells();
+    template <class Scanline>
+    bool SweepRow(Scanline& sl, int32_t y);
+    template <class Scanline, class CellIterator>
+    bool SweepCells(Scanline& sl, CellIterator cells, uint32_t numCells);
+    template <class Scanline, class CellIterator>
+    bool SweepDenseCells(Scanline& sl, CellIterator cells, uint32_t numCells, int32_t startX, uint32_t width);
+
     RasterizerCellsAntiAlias outline_;
     RasterizerScanlineClip clipper_;
+    RecordedVertex* vertices_;
+    uint32_t numVertices_;
+    uint32_t maxVertices_;
+    uint32_t peakCells_;
     int32_t gammar_[AA_SCALE];
+    GeometryPlainDataArray<int32_t> accumCover_;
+    GeometryPlainDataArray<int32_t> accumArea_;
+    GeometryPlainDataArray<uint8_t> accumAlpha_;
     FillingRule fillingRule_;
     bool autoClose_;
+    bool banded_;
+    bool recording_;
     int32_t startX_;
     int32_t startY_;
     uint32_t status_;
     int32_t scanY_;
+    int32_t bandTop_;
+    int32_t bandRows_;
+    int32_t pathMinX_;
+    int32_t pathMinY_;
+    int32_t pathMaxX_;
+    int32_t pathMaxY_;
 };
 } // namespace OHOS
 #endif
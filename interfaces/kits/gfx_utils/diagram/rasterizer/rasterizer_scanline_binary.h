@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_scanline_binary.h
+ * @brief Defines Non anti-aliased (binary) scanline rasterization
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_SCANLINE_BINARY_H
+#define GRAPHIC_LITE_RASTERIZER_SCANLINE_BINARY_H
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_clip.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerEdgesBinary
+ * @brief The edges of a path in 1 / 256 pixel units and where they cross the center of every row,
+ * the outline of RasterizerScanlineBinary like RasterizerCellsAntiAlias is for the anti-aliased rasterizer.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerEdgesBinary {
+public:
+    /**
+     * @brief A crossing of an edge with the center of a row: x is the first pixel whose center is
+     * at or right of it, dir is +1 for an edge going downwards and -1 upwards.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct Crossing {
+        int32_t x;
+        int32_t dir;
+    };
+
+    enum EdgeScale {
+        EDGE_BLOCK_POOL = 256
+    };
+
+    RasterizerEdgesBinary();
+
+    ~RasterizerEdgesBinary();
+
+    void Reset();
+
+    /**
+     * @brief Add an edge, both points with sub pixels. Horizontal edges cross no row center and are skipped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void LineOperate(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    /**
+     * @brief Intersect the edges with the row centers and sort the crossings of every row by x.
+     * Crossings between the same two pixel centers keep any order, no pixel lies between them.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SortAllCrossings();
+
+    bool GetSorted() const
+    {
+        return sorted_;
+    }
+
+    uint32_t GetTotalCrossings() const
+    {
+        return numCrossings_;
+    }
+
+    /**
+     * @brief The pixel range of the rows having crossings, in x the range of the edges.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetMinX() const
+    {
+        return minX_ >> POLY_SUBPIXEL_SHIFT;
+    }
+    int32_t GetMinY() const
+    {
+        return minRow_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_ >> POLY_SUBPIXEL_SHIFT;
+    }
+    int32_t GetMaxY() const
+    {
+        return maxRow_;
+    }
+
+    uint32_t GetScanlineNumCrossings(int32_t yLevel) const
+    {
+        return rowStart_[yLevel - minRow_ + 1] - rowStart_[yLevel - minRow_];
+    }
+
+    const Crossing* GetScanlineCrossings(int32_t yLevel) const
+    {
+        return crossings_.Data() + rowStart_[yLevel - minRow_];
+    }
+
+private:
+    RasterizerEdgesBinary(const RasterizerEdgesBinary&);
+    const RasterizerEdgesBinary& operator=(const RasterizerEdgesBinary&);
+
+    struct BinaryEdge {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        int32_t firstRow;
+        int32_t lastRow;
+    };
+
+    BinaryEdge* edges_;
+    uint32_t numEdges_;
+    uint32_t maxEdges_;
+    uint32_t numCrossings_;
+    GeometryPlainDataArray<Crossing> crossings_;
+    GeometryPlainDataArray<uint32_t> rowStart_;
+    int32_t minX_;
+    int32_t maxX_;
+    int32_t minRow_;
+    int32_t maxRow_;
+    bool sorted_;
+};
+
+/**
+ * @class RasterizerScanlineBinary
+ * @brief Rasterizes a path without anti-aliasing, with the same clipping and vertex interface as
+ * RasterizerScanlineAntialias. A pixel is covered when its center is inside the path, so the spans
+ * are solid with full cover and there is no cell, area or alpha to compute.
+ * Suitable for hard edged shapes such as axis-aligned rectangles and thin guide lines.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerScanlineBinary {
+public:
+    enum RasterizerStatus {
+        STATUS_INITIAL,
+        STATUS_MOVE_TO,
+        STATUS_LINE_TO,
+        STATUS_CLOSED
+    };
+
+    RasterizerScanlineBinary()
+        : outline_(),
+          clipper_(),
+          fillingRule_(FILL_NON_ZERO),
+          autoClose_(true),
+          startX_(0),
+          startY_(0),
+          status_(STATUS_INITIAL),
+          scanY_(0) {}
+
+    void Reset();
+    void ResetClipping();
+    void ClipBox(float x1, float y1, float x2, float y2);
+
+    void SetFillingRule(FillingRule fillingRule)
+    {
+        fillingRule_ = fillingRule;
+    }
+
+    void AutoClose(bool flag)
+    {
+        autoClose_ = flag;
+    }
+
+    void MoveTo(int32_t x, int32_t y);
+    void LineTo(int32_t x, int32_t y);
+    void MoveToByfloat(float x, float y);
+    void LineToByfloat(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        if (outline_.GetSorted()) {
+            Reset();
+        }
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            AddVertex(x, y, cmd);
+        }
+    }
+
+    int32_t GetMinX() const
+    {
+        return outline_.GetMinX();
+    }
+    int32_t GetMinY() const
+    {
+        return outline_.GetMinY();
+    }
+    int32_t GetMaxX() const
+    {
+        return outline_.GetMaxX();
+    }
+    int32_t GetMaxY() const
+    {
+        return outline_.GetMaxY();
+    }
+
+    bool RewindScanlines();
+
+    /**
+     * @brief Fill the next scanline having any covered pixel with solid spans of full cover,
+     * a GeometryScanlinePacked keeps each of them as one cover.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+private:
+    RasterizerScanlineBinary(const RasterizerScanlineBinary&);
+    const RasterizerScanlineBinary& operator=(const RasterizerScanlineBinary&);
+
+    RasterizerEdgesBinary outline_;
+    RasterizerScanlineClip clipper_;
+    FillingRule fillingRule_;
+    bool autoClose_;
+    int32_t startX_;
+    int32_t startY_;
+    uint32_t status_;
+    int32_t scanY_;
+};
+} // namespace OHOS
+#endif
@@ -23,6 +23,7 @@
 #ifndef GRAPHIC_LITE_RASTERIZER_SCANLINE_CLIP_H
 #define GRAPHIC_LITE_RASTERIZER_SCANLINE_CLIP_H
 
+#include "graphic_config.h"
 #include "gfx_utils/diagram/common/common_clip_operate.h"
 #include "gfx_utils/graphic_math.h"
 #include "gfx_utils/diagram/rasterizer/rasterizer_cells_antialias.h"
@@ -37,6 +38,28 @@ enum PolyMaxCoord {
     POLY_MAX_COORD = (1 << 30) - 1
 };
 
+/**
+ * @brief deltaA * deltaB / deltaC rounded to the nearest, halves away from zero as MATH_ROUND32,
+ * with a 64 bit intermediate product, so that clipping needs no float.
+ * It is built whatever ENABLE_FIXED_POINT_CLIP, which only selects it for RasterDepictInt::MultDiv.
+ * @return 0 for a zero deltaC.
+ * @since 1.0
+ * @version 1.0
+ */
+inline int32_t IntegerMultDiv(int32_t deltaA, int32_t deltaB, int32_t deltaC)
+{
+    if (deltaC == 0) {
+        return 0;
+    }
+    int64_t product = static_cast<int64_t>(deltaA) * deltaB;
+    int64_t half = (deltaC > 0 ? deltaC : -static_cast<int64_t>(deltaC)) >> 1;
+    // The division truncates towards zero, so move the product away from zero by half the divisor
+    if (product < 0) {
+        half = -half;
+    }
+    return static_cast<int32_t>((product + half) / deltaC);
+}
+
 /**
  * @struct RasterDepictInt
  * @brief The RasterDepictInt structure is within the target range
@@ -68,6 +91,12 @@ struct RasterDepictInt {
         return vDownscale;
     }
 
+#if ENABLE_FIXED_POINT_CLIP
+    static inline int32_t MultDiv(int32_t deltaA, int32_t deltaB, int32_t dealtaC)
+    {
+        return IntegerMultDiv(deltaA, deltaB, dealtaC);
+    }
+#else
     static inline int32_t MultDiv(float deltaA, float deltaB, float dealtaC)
     {
         if (dealtaC != 0) {
@@ -75,6 +104,7 @@ struct RasterDepictInt {
         }
         return 0;
     }
+#endif
 
     static int32_t GetXCoordinateValue(int32_t xValue)
     {
@@ -125,6 +155,22 @@ public:
         clipping_ = true;
     }
 
+    /**
+     * @brief Whether anything within the bounds, in 1 / 256 pixel units, can reach the clipping range.
+     * Lines left or right of the range only leave cells without coverage on its edges,
+     * so a path outside of it on any side can be skipped as a whole.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsBoxVisible(int32_t x1, int32_t y1, int32_t x2, int32_t y2) const
+    {
+        if (!clipping_) {
+            return true;
+        }
+        return x2 >= clipBox_.GetLeft() && x1 <= clipBox_.GetRight() &&
+               y2 >= clipBox_.GetTop() && y1 <= clipBox_.GetBottom();
+    }
+
     /**
      * @brief In the RASTERIZER process, the starting point of setting is added,
      * And set the flag of clippingFlags_
@@ -154,10 +200,12 @@ public:
      *   1100  |  1000  | 1001
      *         |        |
      *   clip_box.x1  clip_box.x2
+     * The outline is RasterizerCellsAntiAlias or RasterizerEdgesBinary, anything with the same LineOperate.
      * @since 1.0
      * @version 1.0
      */
-    void LineTo(RasterizerCellsAntiAlias& ras, int32_t x2, int32_t y2);
+    template <class Outline>
+    void LineTo(Outline& ras, int32_t x2, int32_t y2);
 
 private:
     /**
@@ -167,7 +215,8 @@ private:
      * @since 1.0
      * @version 1.0
      */
-    inline void LineClipY(RasterizerCellsAntiAlias& ras,
+    template <class Outline>
+    inline void LineClipY(Outline& ras,
                           int32_t x1, int32_t y1,
                           int32_t x2, int32_t y2,
                           uint32_t clipFlagsOne, uint32_t clipFlagsTwo) const;
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_scanline_compound.h
+ * @brief Defines Compound (multi-style) rasterization of several paths
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_SCANLINE_COMPOUND_H
+#define GRAPHIC_LITE_RASTERIZER_SCANLINE_COMPOUND_H
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerScanlineCompound
+ * @brief Rasterizes several paths, each under a style id such as the index of its fill,
+ * and sweeps all of them in a single pass over the rows: SweepStyles moves to the next row
+ * and lists the styles reaching it in ascending order, SweepScanline then gives the spans
+ * of each of them, so overlapping fills are composited row by row instead of one pass per fill.
+ * The cells of every style are built and sorted by its own RasterizerScanlineAntialias,
+ * a style costs nothing on the rows it does not reach.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerScanlineCompound {
+public:
+    /**
+     * @brief The style arrays grow by STYLE_BLOCK_POOL entries at least,
+     * style ids are below MAX_STYLE_ID so that the array of styles stays bounded.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum StyleScale {
+        STYLE_BLOCK_POOL = 16,
+        MAX_STYLE_ID = 1 << 16
+    };
+
+    RasterizerScanlineCompound(uint32_t cellBlockLimit = (1 << (RasterizerScanlineAntialias::AA_SHIFT + 2)));
+
+    ~RasterizerScanlineCompound();
+
+    /**
+     * @brief Reset the cells of every style, the rasterizers of the styles are kept for the next paths.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    void ResetClipping();
+    void ClipBox(float x1, float y1, float x2, float y2);
+    void AutoClose(bool flag);
+
+    /**
+     * @brief Select the style of the vertices added next, style ids are small indices into the caller's fills.
+     * The vertices of a style at or above MAX_STYLE_ID are dropped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetStyle(uint32_t style);
+
+    void MoveTo(int32_t x, int32_t y);
+    void LineTo(int32_t x, int32_t y);
+    void MoveToByfloat(float x, float y);
+    void LineToByfloat(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        if (sorted_) {
+            Reset();
+        }
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            AddVertex(x, y, cmd);
+        }
+    }
+
+    /**
+     * @brief The range boundary value of all styles.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetMinX() const
+    {
+        return minX_;
+    }
+    int32_t GetMinY() const
+    {
+        return minY_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_;
+    }
+    int32_t GetMaxY() const
+    {
+        return maxY_;
+    }
+
+    /**
+     * @brief Sort the cells of every style.
+     * @return Whether any style has cells.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines();
+
+    /**
+     * @brief Move to the next row reached by any style.
+     * @return The number of styles on the row, 0 after the last row.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t SweepStyles();
+
+    /**
+     * @brief The style id of the index-th style on the current row, in ascending order.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetStyle(uint32_t index) const
+    {
+        return scanStyles_[index];
+    }
+
+    int32_t GetScanY() const
+    {
+        return currY_;
+    }
+
+    /**
+     * @brief Sweep the spans of the index-th style on the current row.
+     * @return Whether the style covers any pixel of the row.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl, uint32_t index);
+
+private:
+    RasterizerScanlineCompound(const RasterizerScanlineCompound&);
+    const RasterizerScanlineCompound& operator=(const RasterizerScanlineCompound&);
+
+    RasterizerScanlineAntialias* GetCurrentStyle();
+    bool UseStyle(uint32_t style);
+
+    RasterizerScanlineAntialias** styles_;
+    uint32_t* usedStyles_;
+    uint32_t* scanStyles_;
+    uint32_t maxStyles_;
+    uint32_t numUsed_;
+    uint32_t maxUsed_;
+    uint32_t numActive_;
+    uint32_t numScanStyles_;
+    uint32_t currStyle_;
+    RasterizerScanlineAntialias* current_;
+    uint32_t cellBlockLimit_;
+    float clipLeft_;
+    float clipTop_;
+    float clipRight_;
+    float clipBottom_;
+    bool clipping_;
+    bool autoClose_;
+    bool sorted_;
+    int32_t scanY_;
+    int32_t currY_;
+    int32_t minX_;
+    int32_t minY_;
+    int32_t maxX_;
+    int32_t maxY_;
+};
+} // namespace OHOS
+#endif
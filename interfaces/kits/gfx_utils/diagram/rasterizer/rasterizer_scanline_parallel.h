@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_scanline_parallel.h
+ * @brief Defines Band parallel rasterization of a single path
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_SCANLINE_PARALLEL_H
+#define GRAPHIC_LITE_RASTERIZER_SCANLINE_PARALLEL_H
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+namespace OHOS {
+class GraphicSemaphore;
+
+/**
+ * @class RasterizerScanlineParallel
+ * @brief Rasterizes one path with the same interface as RasterizerScanlineAntialias,
+ * but splits the Y range of the path into horizontal bands.
+ * The cells of every band are built and sorted by its own RasterizerScanlineAntialias
+ * on a worker thread, the scanlines are then swept band by band in order.
+ * The worker of a band is started the first time the band is needed and waits for the next rewind,
+ * so a path drawn every frame does not create threads every frame.
+ * The number of bands follows HalGetCpuCoreNum(), small paths use a single band on the calling thread.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerScanlineParallel {
+public:
+    /**
+     * @brief MAX_BANDS limits the number of bands (and worker threads),
+     * MIN_BAND_ROWS is the smallest band height worth a thread.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum BandScale {
+        MAX_BANDS = 8,
+        MIN_BAND_ROWS = 32,
+        VERTEX_BLOCK_POOL = 256
+    };
+
+    RasterizerScanlineParallel(uint32_t cellBlockLimit = (1 << (RasterizerScanlineAntialias::AA_SHIFT + 2)));
+
+    ~RasterizerScanlineParallel();
+
+    /**
+     * @brief Reset the recorded path and the cells of every band.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    void ResetClipping();
+    void ClipBox(float x1, float y1, float x2, float y2);
+
+    void AutoClose(bool flag)
+    {
+        autoClose_ = flag;
+    }
+
+    /**
+     * @brief Set the gamma table of every band, see RasterizerScanlineAntialias::Gamma.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class GammaFunction>
+    void Gamma(const GammaFunction& gammaFunction)
+    {
+        WaitAllBands();
+        for (uint32_t band = 0; band < MAX_BANDS; band++) {
+            if (bands_[band] == nullptr) {
+                bands_[band] = NewBand();
+            }
+            bands_[band]->Gamma(gammaFunction);
+        }
+    }
+
+    /**
+     * @brief Limit the number of bands, e.g. to leave cores to other work. 0 means HalGetCpuCoreNum().
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetMaxBands(uint32_t maxBands)
+    {
+        maxBands_ = maxBands;
+    }
+
+    void MoveTo(int32_t x, int32_t y);
+    void LineTo(int32_t x, int32_t y);
+    void MoveToByfloat(float x, float y);
+    void LineToByfloat(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        if (sorted_) {
+            Reset();
+        }
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            AddVertex(x, y, cmd);
+        }
+    }
+
+    /**
+     * @brief See RasterizerScanlineAntialias::IsPathVisible.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsPathVisible(float x1, float y1, float x2, float y2) const
+    {
+        if (!clipping_) {
+            return true;
+        }
+        return MATH_MAX(x1, x2) >= clipLeft_ && MATH_MIN(x1, x2) <= clipRight_ &&
+               MATH_MAX(y1, y2) >= clipTop_ && MATH_MIN(y1, y2) <= clipBottom_;
+    }
+
+    template <typename VertexSource>
+    bool AddPathCulled(VertexSource& vs, float x1, float y1, float x2, float y2, uint32_t pathId = 0)
+    {
+        if (sorted_) {
+            Reset();
+        }
+        if (!IsPathVisible(x1, y1, x2, y2)) {
+            return false;
+        }
+        AddPath(vs, pathId);
+        return true;
+    }
+
+    /**
+     * @brief The range boundary value of the recorded path, limited to the clip box.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetMinX() const
+    {
+        return minX_;
+    }
+    int32_t GetMinY() const
+    {
+        return minY_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_;
+    }
+    int32_t GetMaxY() const
+    {
+        return maxY_;
+    }
+
+    /**
+     * @brief Split the path into bands and start building and sorting the cells of every band.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines();
+
+    /**
+     * @brief Sweep the next scanline, waiting for the band that holds it when necessary.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief Build and sort the cells of one band, runs on the worker threads.
+     * @since 1.0
+     * @version 1.0
+     */
+    void RasterizeBand(uint32_t band);
+
+    /**
+     * @brief The loop of the worker thread of a band, rasterizing the band on every rewind until destruction.
+     * @since 1.0
+     * @version 1.0
+     */
+    void RunBandWorker(uint32_t band);
+
+    /**
+     * @brief The argument of a worker thread.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct BandTask {
+        RasterizerScanlineParallel* owner;
+        uint32_t band;
+    };
+
+private:
+    struct BandVertex {
+        int32_t x;
+        int32_t y;
+        uint32_t cmd;
+    };
+
+    RasterizerScanlineParallel(const RasterizerScanlineParallel&);
+    const RasterizerScanlineParallel& operator=(const RasterizerScanlineParallel&);
+
+    void AddBandVertex(int32_t x, int32_t y, uint32_t cmd);
+    RasterizerScanlineAntialias* NewBand() const;
+    uint32_t CalculateBands() const;
+    bool StartBandWorker(uint32_t band);
+    void WaitBand(uint32_t band);
+    void WaitAllBands();
+
+    RasterizerScanlineAntialias* bands_[MAX_BANDS];
+    GraphicSemaphore* bandDone_[MAX_BANDS];
+    GraphicSemaphore* bandStart_[MAX_BANDS];
+    bool bandWorker_[MAX_BANDS];
+    BandTask bandTasks_[MAX_BANDS];
+    bool bandPending_[MAX_BANDS];
+    bool bandHasCells_[MAX_BANDS];
+    int32_t bandTop_[MAX_BANDS + 1];
+    BandVertex* vertices_;
+    uint32_t numVertices_;
+    uint32_t maxVertices_;
+    uint32_t cellBlockLimit_;
+    uint32_t maxBands_;
+    uint32_t numBands_;
+    uint32_t currBand_;
+    float clipLeft_;
+    float clipTop_;
+    float clipRight_;
+    float clipBottom_;
+    bool clipping_;
+    bool autoClose_;
+    bool sorted_;
+    bool stopWorkers_;
+    int32_t minX_;
+    int32_t minY_;
+    int32_t maxX_;
+    int32_t maxY_;
+};
+} // namespace OHOS
+#endif
@@ -33,27 +33,30 @@
 namespace OHOS {
 /**
  * @class ScanlineUnPackedContainer
- * @brief 16 bit unpacked scan line container class - packed scan line container,
+ * @brief Unpacked scan line container class - packed scan line container,
  * Containers can contain de aliasing information Unpacked scanline always
  * saves overlay values for all pixels（coverage value）,
- * Include those pixels that all cover the interior of the polygon
+ * Include those pixels that all cover the interior of the polygon.
+ * CoordType is the type of the span x and length: GeometryScanline keeps them in 16 bits,
+ * which limits a scanline to 32767 pixels, GeometryScanline32 in 32 bits for large surfaces.
  * @since 1.0
  * @version 1.0
  */
-class GeometryScanline {
+template <class CoordType>
+class GeometryScanlineBase {
 public:
     /**
      * Pixel coverage type
      */
     struct SpanBlock {
-        int16_t x;
-        int16_t spanLength;
+        CoordType x;
+        CoordType spanLength;
         uint8_t* covers;
     };
     using Iterator = SpanBlock* ;
     using ConstIterator = const SpanBlock* ;
-    GeometryScanline() : minScaneLineXCoord_(0), lastScaneLineXCoord_(0x7FFFFFF0),
-                         scaneLineYCoord_(0), curSpanBlock_(0) {}
+    GeometryScanlineBase() : minScaneLineXCoord_(0), lastScaneLineXCoord_(0x7FFFFFF0),
+                             scaneLineYCoord_(0), curSpanBlock_(0) {}
     /**
      * @class ScanlineUnPackedContainer
      * @brief 16 bit unpacked scan line container class - packed scan line container,
@@ -90,7 +93,7 @@ public:
             curSpanBlock_->spanLength++;
         } else {
             curSpanBlock_++;
-            curSpanBlock_->x = static_cast<int16_t>(x + minScaneLineXCoord_);
+            curSpanBlock_->x = static_cast<CoordType>(x + minScaneLineXCoord_);
             curSpanBlock_->spanLength = 1;
             curSpanBlock_->covers = &arrayCovers_[x];
         }
@@ -110,11 +113,11 @@ public:
             return;
         }
         if (x == lastScaneLineXCoord_ + 1) {
-            curSpanBlock_->spanLength += static_cast<int16_t>(cellLength);
+            curSpanBlock_->spanLength += static_cast<CoordType>(cellLength);
         } else {
             curSpanBlock_++;
-            curSpanBlock_->x = static_cast<int16_t>(x + minScaneLineXCoord_);
-            curSpanBlock_->spanLength = static_cast<int16_t>(cellLength);
+            curSpanBlock_->x = static_cast<CoordType>(x + minScaneLineXCoord_);
+            curSpanBlock_->spanLength = static_cast<CoordType>(cellLength);
             curSpanBlock_->covers = &arrayCovers_[x];
         }
         lastScaneLineXCoord_ = x + cellLength - 1;
@@ -134,11 +137,11 @@ public:
             return;
         }
         if (x == lastScaneLineXCoord_ + 1) {
-            curSpanBlock_->spanLength += static_cast<int16_t>(spanLength);
+            curSpanBlock_->spanLength += static_cast<CoordType>(spanLength);
         } else {
             curSpanBlock_++;
-            curSpanBlock_->x = static_cast<int16_t>(x + minScaneLineXCoord_);
-            curSpanBlock_->spanLength = static_cast<int16_t>(spanLength);
+            curSpanBlock_->x = static_cast<CoordType>(x + minScaneLineXCoord_);
+            curSpanBlock_->spanLength = static_cast<CoordType>(spanLength);
             curSpanBlock_->covers = &arrayCovers_[x];
         }
         lastScaneLineXCoord_ = x + spanLength - 1;
@@ -175,8 +178,8 @@ public:
     }
 
 private:
-    GeometryScanline(const GeometryScanline&);
-    const GeometryScanline& operator=(const GeometryScanline&);
+    GeometryScanlineBase(const GeometryScanlineBase&);
+    const GeometryScanlineBase& operator=(const GeometryScanlineBase&);
 
 private:
     int32_t minScaneLineXCoord_;
@@ -186,5 +189,8 @@ private:
     GeometryPlainDataArray<SpanBlock> arraySpans_;
     SpanBlock* curSpanBlock_;
 };
+
+using GeometryScanline = GeometryScanlineBase<int16_t>;
+using GeometryScanline32 = GeometryScanlineBase<int32_t>;
 } // namespace OHOS
 #endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file geometry_scanline_packed.h
+ *
+ * @brief The packed (run-length) scanline container, filled by the rasterizers like GeometryScanline.
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_GEOMETRY_SCANLINE_PACKED_H
+#define GRAPHIC_LITE_GEOMETRY_SCANLINE_PACKED_H
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+#include "gfx_utils/graphic_log.h"
+
+namespace OHOS {
+/**
+ * @class GeometryScanlinePackedBase
+ * @brief Packed scan line container class. Unlike GeometryScanline, which keeps a cover
+ * for every pixel, a solid span added by AddSpan keeps one cover for all of its pixels and
+ * has a negative spanLength, so a renderer can fill it without reading a cover per pixel:
+ *     if (span->spanLength < 0) fill -spanLength pixels with *span->covers
+ *     else blend spanLength pixels with span->covers[0 .. spanLength - 1]
+ * CoordType is the type of the span x and length, as for GeometryScanlineBase.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class CoordType>
+class GeometryScanlinePackedBase {
+public:
+    /**
+     * Pixel coverage type, a negative spanLength is a solid span of the cover *covers.
+     */
+    struct SpanBlock {
+        CoordType x;
+        CoordType spanLength;
+        uint8_t* covers;
+    };
+    using Iterator = SpanBlock* ;
+    using ConstIterator = const SpanBlock* ;
+    GeometryScanlinePackedBase() : lastScaneLineXCoord_(0x7FFFFFF0), scaneLineYCoord_(0),
+                                   curSpanBlock_(0), curCover_(0) {}
+
+    /**
+     * @brief Prepare for the spans between minX and maxX.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset(int32_t minX, int32_t maxX)
+    {
+        const int32_t liftNumber = 2;
+        uint32_t maxLen = maxX - minX + liftNumber;
+        if (maxLen > arraySpans_.GetSize()) {
+            arraySpans_.Resize(maxLen);
+            arrayCovers_.Resize(maxLen);
+        }
+        ResetSpans();
+    }
+
+    /**
+     * Add a cell, extending the last span when it is adjacent and not solid.
+     */
+    void AddCell(int32_t x, uint32_t cover)
+    {
+        *curCover_ = static_cast<uint8_t>(cover);
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength++;
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<CoordType>(x);
+            curSpanBlock_->spanLength = 1;
+            curSpanBlock_->covers = curCover_;
+        }
+        curCover_++;
+        lastScaneLineXCoord_ = x;
+    }
+
+    /**
+     * Add cellLength cells, extending the last span when it is adjacent and not solid.
+     */
+    void AddCells(int32_t x, uint32_t cellLength, const uint8_t* covers)
+    {
+        if (memcpy_s(curCover_, cellLength * sizeof(uint8_t), covers, cellLength * sizeof(uint8_t)) != EOK) {
+            GRAPHIC_LOGE("AddCells fail");
+            return;
+        }
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength += static_cast<CoordType>(cellLength);
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<CoordType>(x);
+            curSpanBlock_->spanLength = static_cast<CoordType>(cellLength);
+            curSpanBlock_->covers = curCover_;
+        }
+        curCover_ += cellLength;
+        lastScaneLineXCoord_ = x + cellLength - 1;
+    }
+
+    /**
+     * Add a solid span of one cover, merged into the last span when it is an adjacent solid span of the same cover.
+     */
+    void AddSpan(int32_t x, uint32_t spanLength, uint32_t cover)
+    {
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength < 0 && cover == *curSpanBlock_->covers) {
+            curSpanBlock_->spanLength -= static_cast<CoordType>(spanLength);
+        } else {
+            *curCover_ = static_cast<uint8_t>(cover);
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<CoordType>(x);
+            curSpanBlock_->spanLength = -static_cast<CoordType>(spanLength);
+            curSpanBlock_->covers = curCover_++;
+        }
+        lastScaneLineXCoord_ = x + spanLength - 1;
+    }
+
+    /**
+     * End operation
+     */
+    void Finalize(int32_t y)
+    {
+        scaneLineYCoord_ = y;
+    }
+    void ResetSpans()
+    {
+        lastScaneLineXCoord_ = 0x7FFFFFF0;
+        curCover_ = arrayCovers_.Data();
+        curSpanBlock_ = arraySpans_.Data();
+        curSpanBlock_->spanLength = 0;
+    }
+
+    int32_t GetYLevel() const
+    {
+        return scaneLineYCoord_;
+    }
+    uint32_t NumSpans() const
+    {
+        return uint32_t(curSpanBlock_ - &arraySpans_[0]);
+    }
+    ConstIterator Begin() const
+    {
+        return &arraySpans_[1];
+    }
+    Iterator Begin()
+    {
+        return &arraySpans_[1];
+    }
+
+private:
+    GeometryScanlinePackedBase(const GeometryScanlinePackedBase&);
+    const GeometryScanlinePackedBase& operator=(const GeometryScanlinePackedBase&);
+
+    int32_t lastScaneLineXCoord_;
+    int32_t scaneLineYCoord_;
+    GeometryPlainDataArray<uint8_t> arrayCovers_;
+    GeometryPlainDataArray<SpanBlock> arraySpans_;
+    SpanBlock* curSpanBlock_;
+    uint8_t* curCover_;
+};
+
+using GeometryScanlinePacked = GeometryScanlinePackedBase<int16_t>;
+using GeometryScanlinePacked32 = GeometryScanlinePackedBase<int32_t>;
+} // namespace OHOS
+#endif
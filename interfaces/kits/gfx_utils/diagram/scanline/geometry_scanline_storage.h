@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file geometry_scanline_storage.h
+ *
+ * @brief Storage of the swept scanlines of a shape, replayed like a rasterizer.
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_GEOMETRY_SCANLINE_STORAGE_H
+#define GRAPHIC_LITE_GEOMETRY_SCANLINE_STORAGE_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+
+namespace OHOS {
+/**
+ * @class GeometryScanlineStorage
+ * @brief Records the spans and covers swept from a rasterizer once, for a shape that is drawn
+ * again and again with only its color or position changing.
+ * The storage then stands in for the rasterizer: RewindScanlines, GetMinX ... GetMaxY and
+ * SweepScanline replay the recorded scanlines, optionally moved by a whole pixel translation,
+ * without flattening, stroking, building or sorting cells again.
+ * Solid spans keep a single cover, so the interior of a shape costs one cover per span.
+ * @since 1.0
+ * @version 1.0
+ */
+class GeometryScanlineStorage {
+public:
+    enum StorageScale {
+        STORAGE_BLOCK_POOL = 256
+    };
+
+    GeometryScanlineStorage()
+        : spans_(nullptr),
+          rows_(nullptr),
+          covers_(nullptr),
+          numSpans_(0),
+          maxSpans_(0),
+          numRows_(0),
+          maxRows_(0),
+          numCovers_(0),
+          maxCovers_(0),
+          minX_(0),
+          minY_(0),
+          maxX_(0),
+          maxY_(0),
+          dx_(0),
+          dy_(0),
+          curRow_(0) {}
+
+    ~GeometryScanlineStorage()
+    {
+        if (spans_ != nullptr) {
+            GeometryArrayAllocator<StoredSpan>::Deallocate(spans_, maxSpans_);
+        }
+        if (rows_ != nullptr) {
+            GeometryArrayAllocator<StoredRow>::Deallocate(rows_, maxRows_);
+        }
+        if (covers_ != nullptr) {
+            GeometryArrayAllocator<uint8_t>::Deallocate(covers_, maxCovers_);
+        }
+    }
+
+    /**
+     * @brief Drop the recorded scanlines, keeping the memory for the next recording.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset()
+    {
+        numSpans_ = 0;
+        numRows_ = 0;
+        numCovers_ = 0;
+        curRow_ = 0;
+    }
+
+    /**
+     * @brief Sweep all the scanlines of a rasterizer, after its path is added, and keep them.
+     * The scanline is only used while recording and may be shared by all the stored shapes,
+     * a GeometryScanlinePacked32 is the cheapest to store from.
+     * @return Whether the rasterizer has any scanline.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Rasterizer, class Scanline>
+    bool Record(Rasterizer& ras, Scanline& sl)
+    {
+        Reset();
+        if (!ras.RewindScanlines()) {
+            return false;
+        }
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        while (ras.SweepScanline(sl)) {
+            AddScanline(sl);
+        }
+        return numRows_ != 0;
+    }
+
+    /**
+     * @brief Keep one swept scanline, the scanlines are added from top to bottom.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    void AddScanline(const Scanline& sl)
+    {
+        uint32_t numSpans = sl.NumSpans();
+        if (numSpans == 0 || !Reserve(rows_, maxRows_, numRows_, 1) ||
+            !Reserve(spans_, maxSpans_, numSpans_, numSpans)) {
+            return;
+        }
+        typename Scanline::ConstIterator span = sl.Begin();
+        int32_t minX = span->x;
+        int32_t maxX = span->x;
+        uint32_t firstSpan = numSpans_;
+        uint32_t firstCover = numCovers_;
+        for (uint32_t i = 0; i < numSpans; i++, span++) {
+            int32_t spanLength = span->spanLength;
+            uint32_t numCovers = (spanLength < 0) ? 1 : static_cast<uint32_t>(spanLength);
+            if (!Reserve(covers_, maxCovers_, numCovers_, numCovers) ||
+                memcpy_s(covers_ + numCovers_, numCovers, span->covers, numCovers) != EOK) {
+                GRAPHIC_LOGE("GeometryScanlineStorage::AddScanline fail\n");
+                numSpans_ = firstSpan;
+                numCovers_ = firstCover;
+                return;
+            }
+            StoredSpan& stored = spans_[numSpans_++];
+            stored.x = span->x;
+            stored.spanLength = spanLength;
+            stored.coverIndex = numCovers_;
+            numCovers_ += numCovers;
+            maxX = span->x + ((spanLength < 0) ? -spanLength : spanLength) - 1;
+        }
+        StoredRow& row = rows_[numRows_];
+        row.y = sl.GetYLevel();
+        row.firstSpan = firstSpan;
+        row.numSpans = numSpans;
+        if (numRows_ == 0) {
+            minX_ = minX;
+            maxX_ = maxX;
+            minY_ = row.y;
+        } else {
+            minX_ = MATH_MIN(minX_, minX);
+            maxX_ = MATH_MAX(maxX_, maxX);
+        }
+        maxY_ = row.y;
+        ++numRows_;
+    }
+
+    /**
+     * @brief Move the replayed scanlines by whole pixels, e.g. to draw the shape at another position.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetTranslation(int32_t dx, int32_t dy)
+    {
+        dx_ = dx;
+        dy_ = dy;
+    }
+
+    bool RewindScanlines()
+    {
+        curRow_ = 0;
+        return numRows_ != 0;
+    }
+
+    int32_t GetMinX() const
+    {
+        return minX_ + dx_;
+    }
+    int32_t GetMinY() const
+    {
+        return minY_ + dy_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_ + dx_;
+    }
+    int32_t GetMaxY() const
+    {
+        return maxY_ + dy_;
+    }
+
+    /**
+     * @brief Replay the next recorded scanline, solid spans are added as spans of their cover.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl)
+    {
+        if (curRow_ >= numRows_) {
+            return false;
+        }
+        const StoredRow& row = rows_[curRow_++];
+        sl.ResetSpans();
+        const StoredSpan* span = spans_ + row.firstSpan;
+        for (uint32_t i = 0; i < row.numSpans; i++, span++) {
+            if (span->spanLength < 0) {
+                sl.AddSpan(span->x + dx_, static_cast<uint32_t>(-span->spanLength), covers_[span->coverIndex]);
+            } else {
+                sl.AddCells(span->x + dx_, static_cast<uint32_t>(span->spanLength), covers_ + span->coverIndex);
+            }
+        }
+        sl.Finalize(row.y + dy_);
+        return true;
+    }
+
+    uint32_t GetNumScanlines() const
+    {
+        return numRows_;
+    }
+
+    /**
+     * @brief The bytes held by the stored shape, including the memory kept for growing.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetMemorySize() const
+    {
+        return sizeof(GeometryScanlineStorage) + maxSpans_ * sizeof(StoredSpan) + maxRows_ * sizeof(StoredRow) +
+               maxCovers_ * sizeof(uint8_t);
+    }
+
+    /**
+     * @brief The bytes of the recorded scanlines only.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetUsedMemorySize() const
+    {
+        return numSpans_ * sizeof(StoredSpan) + numRows_ * sizeof(StoredRow) + numCovers_ * sizeof(uint8_t);
+    }
+
+private:
+    GeometryScanlineStorage(const GeometryScanlineStorage&);
+    const GeometryScanlineStorage& operator=(const GeometryScanlineStorage&);
+
+    /**
+     * @brief A span as in a packed scanline, a negative spanLength is a solid span of one cover.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct StoredSpan {
+        int32_t x;
+        int32_t spanLength;
+        uint32_t coverIndex;
+    };
+
+    struct StoredRow {
+        int32_t y;
+        uint32_t firstSpan;
+        uint32_t numSpans;
+    };
+
+    /**
+     * @brief Make room for count more elements after the used ones, keeping them.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class T>
+    static bool Reserve(T*& data, uint32_t& capacity, uint32_t used, uint32_t count)
+    {
+        if (used + count <= capacity) {
+            return true;
+        }
+        uint32_t newCapacity = MATH_MAX(capacity + STORAGE_BLOCK_POOL + (capacity >> 1), used + count);
+        T* newData = GeometryArrayAllocator<T>::Allocate(newCapacity);
+        if (newData == nullptr) {
+            GRAPHIC_LOGE("GeometryScanlineStorage::Reserve allocate fail\n");
+            return false;
+        }
+        if (data != nullptr) {
+            if (used != 0 && memcpy_s(newData, newCapacity * sizeof(T), data, used * sizeof(T)) != EOK) {
+                GRAPHIC_LOGE("GeometryScanlineStorage::Reserve memcpy_s fail\n");
+            }
+            GeometryArrayAllocator<T>::Deallocate(data, capacity);
+        }
+        data = newData;
+        capacity = newCapacity;
+        return true;
+    }
+
+    StoredSpan* spans_;
+    StoredRow* rows_;
+    uint8_t* covers_;
+    uint32_t numSpans_;
+    uint32_t maxSpans_;
+    uint32_t numRows_;
+    uint32_t maxRows_;
+    uint32_t numCovers_;
+    uint32_t maxCovers_;
+    int32_t minX_;
+    int32_t minY_;
+    int32_t maxX_;
+    int32_t maxY_;
+    int32_t dx_;
+    int32_t dy_;
+    uint32_t curRow_;
+};
+} // namespace OHOS
+#endif
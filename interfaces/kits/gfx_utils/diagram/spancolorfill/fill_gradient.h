@@ -24,6 +24,7 @@
 #ifndef GRAPHIC_LITE_FILL_GRADIENT_H
 #define GRAPHIC_LITE_FILL_GRADIENT_H
 
+#include <cmath>
 
 #include "gfx_utils/color.h"
 #include "gfx_utils/diagram/common/common_basics.h"
@@ -31,6 +32,7 @@
 #include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
 #include "gfx_utils/graphic_math.h"
 #include "fill_base.h"
+#include "graphic_neon_utils.h"
 namespace OHOS {
 class Gradient {
 public:
@@ -71,7 +73,8 @@ public:
     void Prepare() {}
 
     /**
-     * @brief Generate From colorfunction_ Remove the rgba from the span
+     * @brief Generate From colorfunction_ Remove the rgba from the span,
+     * premultiplied when the colorfunction_ is, see FillGradientLut::SetPremultiplied
      * @param span First address of scan line to be filled
      * @param x coordinate-x
      * @param y coordinate-y
@@ -161,6 +164,31 @@ public:
         return index;
     }
 
+    int32_t GetEndRadius() const
+    {
+        return endRadius_;
+    }
+
+    int32_t GetCenterDistanceX() const
+    {
+        return dx_;
+    }
+
+    int32_t GetCenterDistanceY() const
+    {
+        return dy_;
+    }
+
+    /**
+     * @brief The factor of the distance to the start circle center along the ray, giving its radius
+     * @since 1.0
+     * @version 1.0
+     */
+    float GetMultiplier() const
+    {
+        return mul_;
+    }
+
 private:
     /**
      * @brief update mul_
@@ -232,5 +260,544 @@ public:
     }
 #endif
 };
+
+/**
+ * @brief The subscript of the current (x, y) ColorFunction array when calculating a sweep (conic) gradient:
+ * the angle of (x, y) around the origin, clockwise from the x-axis as the y-axis points down,
+ * running from the start angle to the end angle.
+ * The interpolator places the center at the origin, and the distances of FillGradient are not used.
+ * @since 1.0
+ * @version 1.0
+ */
+class GradientSweepCalculate : public virtual Gradient {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    GradientSweepCalculate()
+    {
+        SetAngles(0, CIRCLE_IN_DEGREE);
+    }
+
+    /**
+     * @brief GradientSweepCalculate Constructor arguments
+     * @param startAngle The angle of the first color, in degrees
+     * @param endAngle The angle of the last color, in degrees, a full circle when not after the start angle
+     * or more than a circle after it. A NaN or infinite angle gives the full circle from 0 degrees.
+     */
+    GradientSweepCalculate(float startAngle, float endAngle)
+    {
+        SetAngles(startAngle, endAngle);
+    }
+
+    /**
+     * @brief The subscript of the current (x, y) ColorFunction array when calculating a sweep gradient
+     * @param x coordinate x
+     * @param y coordinate y
+     * @param size The size of colorFunction
+     * @return
+     */
+    int16_t Calculate(int16_t x, int16_t y, int16_t, int16_t, int16_t size)
+    {
+        return static_cast<int16_t>(AngleToIndex(FastAtan2F(y, x), size));
+    }
+
+    /**
+     * @brief The subscript of the ColorFunction array of an angle from FastAtan2F.
+     * @param angle The angle in radians, from -pi to pi
+     * @param size The size of colorFunction
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t AngleToIndex(float angle, int32_t size) const
+    {
+        angle -= startAngle_;
+        if (angle < 0) {
+            angle += static_cast<float>(2 * UI_PI); // 2: a circle
+        }
+        if (angle < 0) {
+            angle += static_cast<float>(2 * UI_PI); // 2: a circle
+        }
+        int32_t index = static_cast<int32_t>(angle * indexScale_ * size);
+        return MATH_MIN(index, size - 1);
+    }
+
+    /** The start angle in radians, from 0 to 2 pi */
+    float GetStartAngle() const
+    {
+        return startAngle_;
+    }
+
+    /** The reciprocal of the angle from the start angle to the end angle, in radians */
+    float GetIndexScale() const
+    {
+        return indexScale_;
+    }
+
+private:
+    void SetAngles(float startAngle, float endAngle)
+    {
+        if (!std::isfinite(startAngle) || !std::isfinite(endAngle)) {
+            startAngle = 0;
+            endAngle = CIRCLE_IN_DEGREE;
+        }
+        float sweepAngle = endAngle - startAngle;
+        if (sweepAngle <= 0 || sweepAngle > CIRCLE_IN_DEGREE) {
+            sweepAngle = CIRCLE_IN_DEGREE;
+        }
+        startAngle = fmodf(startAngle, CIRCLE_IN_DEGREE);
+        if (startAngle < 0) {
+            startAngle += CIRCLE_IN_DEGREE;
+        }
+        // A tiny negative angle plus a circle rounds up to the circle
+        if (startAngle >= CIRCLE_IN_DEGREE) {
+            startAngle = 0;
+        }
+        startAngle_ = startAngle / RADIAN_TO_ANGLE;
+        indexScale_ = RADIAN_TO_ANGLE / sweepAngle;
+    }
+
+    float startAngle_;
+    float indexScale_;
+#endif
+};
+
+/**
+ * @brief Gradient scanline fill with the gradient function known at compile time,
+ * e.g. FillGradientSpan<GradientRadialCalculate>, so that its Calculate is not called virtually per pixel.
+ * The parameters are those of FillGradient.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class GradientFunction>
+class FillGradientSpan : public SpanBase {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    FillGradientSpan(FillInterpolator& inter, GradientFunction& gradientFunction,
+                     FillGradientLut& colorFunction, float distance1, float distance2)
+        : interpolator_(&inter),
+          gradientFunction_(&gradientFunction),
+          colorFunction_(&colorFunction),
+          distance1_(static_cast<int32_t>(distance1 * GRADIENT_SUBPIXEL_SCALE)),
+          distance2_(static_cast<int32_t>(distance2 * GRADIENT_SUBPIXEL_SCALE)) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        int32_t downscaleShift = FillInterpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT;
+        int16_t size = static_cast<int16_t>(colorFunction_->GetSize());
+        interpolator_->Begin(x, y, len);
+        for (; len; --len, ++(*interpolator_), span++) {
+            interpolator_->Coordinates(&x, &y);
+            int32_t index = gradientFunction_->GradientFunction::Calculate(x >> downscaleShift,
+                y >> downscaleShift, distance1_, distance2_, size);
+            const Rgba8T& color = (*colorFunction_)[index];
+            span->red = color.red;
+            span->green = color.green;
+            span->blue = color.blue;
+            span->alpha = color.alpha;
+        }
+    }
+
+private:
+    FillInterpolator* interpolator_;
+    GradientFunction* gradientFunction_;
+    FillGradientLut* colorFunction_;
+    int32_t distance1_;
+    int32_t distance2_;
+#endif
+};
+
+/**
+ * @brief Linear gradient scanline fill.
+ * The LUT index of a linear gradient is an affine function of x along a scanline,
+ * so it is found at both ends of the span once and stepped in fixed point,
+ * the pixels before and after the gradient repeating its end colors without computing any index.
+ * @since 1.0
+ * @version 1.0
+ */
+template <>
+class FillGradientSpan<GradientLinearCalculate> : public SpanBase {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    /**
+     * @brief The LUT index is stepped in 1 / (1 << GRADIENT_INDEX_SHIFT) entries.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum GradientIndexScale {
+        GRADIENT_INDEX_SHIFT = 16
+    };
+
+    FillGradientSpan(FillInterpolator& inter, GradientLinearCalculate&,
+                     FillGradientLut& colorFunction, float, float distance2)
+        : interpolator_(&inter),
+          colorFunction_(&colorFunction),
+          distance_(MATH_MAX(static_cast<int32_t>(distance2 * GRADIENT_SUBPIXEL_SCALE), 1)) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        if (len == 0) {
+            return;
+        }
+        int32_t x1;
+        int32_t x2;
+        int32_t ty;
+        interpolator_->TransformSubpixel(x, y, &x1, &ty);
+        interpolator_->TransformSubpixel(x + static_cast<int32_t>(len), y, &x2, &ty);
+        int64_t size = colorFunction_->GetSize();
+        // x is in 1 / SUBPIXEL_SCALE pixels and the distance in 1 / GRADIENT_SUBPIXEL_SCALE pixels
+        int32_t shift = GRADIENT_INDEX_SHIFT - (FillInterpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT);
+        int64_t position = (static_cast<int64_t>(x1) * size * (1 << shift)) / distance_;
+        int64_t step = (static_cast<int64_t>(x2 - x1) * size * (1 << shift)) / (static_cast<int64_t>(distance_) * len);
+        int64_t limit = size << GRADIENT_INDEX_SHIFT;
+        const Rgba8T* colors = &(*colorFunction_)[0];
+        const Rgba8T& first = colors[0];
+        const Rgba8T& last = colors[size - 1];
+        if (step >= 0) {
+            for (; len && position < 0; --len, position += step) {
+                CopyColor(span++, first);
+            }
+            for (; len && position < limit; --len, position += step) {
+                CopyColor(span++, colors[position >> GRADIENT_INDEX_SHIFT]);
+            }
+            for (; len; --len) {
+                CopyColor(span++, last);
+            }
+        } else {
+            for (; len && position >= limit; --len, position += step) {
+                CopyColor(span++, last);
+            }
+            for (; len && position >= 0; --len, position += step) {
+                CopyColor(span++, colors[position >> GRADIENT_INDEX_SHIFT]);
+            }
+            for (; len; --len) {
+                CopyColor(span++, first);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Copy the channels, which the compiler merges into a single move,
+     * unlike the assignment of Rgba8T that converts through Rgba.
+     * @since 1.0
+     * @version 1.0
+     */
+    static inline void CopyColor(Rgba8T* dst, const Rgba8T& src)
+    {
+        dst->red = src.red;
+        dst->green = src.green;
+        dst->blue = src.blue;
+        dst->alpha = src.alpha;
+    }
+
+    FillInterpolator* interpolator_;
+    FillGradientLut* colorFunction_;
+    int32_t distance_;
+#endif
+};
+
+/**
+ * @brief Radial gradient scanline fill.
+ * Along a scanline, the value under the square root of GradientRadialCalculate is a quadratic of the pixel
+ * and the rest of the LUT index is linear, so both are stepped by forward differences,
+ * leaving one square root per pixel, four at a time with NEON.
+ * Concentric circles, the usual case, have no linear part and only step the quadratic.
+ * @since 1.0
+ * @version 1.0
+ */
+template <>
+class FillGradientSpan<GradientRadialCalculate> : public SpanBase {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    FillGradientSpan(FillInterpolator& inter, GradientRadialCalculate& gradientFunction,
+                     FillGradientLut& colorFunction, float distance1, float distance2)
+        : interpolator_(&inter),
+          gradientFunction_(&gradientFunction),
+          colorFunction_(&colorFunction),
+          distance1_(static_cast<int32_t>(distance1 * GRADIENT_SUBPIXEL_SCALE)),
+          distance2_(static_cast<int32_t>(distance2 * GRADIENT_SUBPIXEL_SCALE)) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        if (len == 0) {
+            return;
+        }
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        interpolator_->TransformSubpixel(x, y, &x1, &y1);
+        interpolator_->TransformSubpixel(x + static_cast<int32_t>(len), y, &x2, &y2);
+        // The positions relative to the start circle center and their steps, in 1 / GRADIENT_SUBPIXEL_SCALE pixels
+        const float downscale = 1.0f / (1 << (FillInterpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT));
+        float centerX = static_cast<float>(gradientFunction_->GetCenterDistanceX());
+        float centerY = static_cast<float>(gradientFunction_->GetCenterDistanceY());
+        float px = x1 * downscale - centerX;
+        float py = y1 * downscale - centerY;
+        float ax = (x2 - x1) * downscale / len;
+        float ay = (y2 - y1) * downscale / len;
+        float deltaRadius = MATH_MAX(static_cast<float>(distance2_ - distance1_), 1.0f);
+        float indexScale = colorFunction_->GetSize() / deltaRadius;
+
+        RadialSteps steps;
+        float quadraticA;
+        float quadraticB;
+        float quadraticC;
+        bool concentric = (centerX == 0 && centerY == 0);
+        if (concentric) {
+            // The radius through a pixel is its distance to the center
+            quadraticA = px * px + py * py;
+            quadraticB = 2.0f * (px * ax + py * ay); // 2: from (p + a * i)^2
+            quadraticC = ax * ax + ay * ay;
+            steps.rootScale = indexScale;
+            steps.linear = -distance1_ * indexScale;
+            steps.linearStep = 0;
+        } else {
+            float radiusSquare = static_cast<float>(gradientFunction_->GetEndRadius());
+            radiusSquare *= radiusSquare;
+            float cross = px * centerY - py * centerX;
+            float crossStep = ax * centerY - ay * centerX;
+            quadraticA = radiusSquare * (px * px + py * py) - cross * cross;
+            quadraticB = 2.0f * (radiusSquare * (px * ax + py * ay) - cross * crossStep); // 2: from (p + a * i)^2
+            quadraticC = radiusSquare * (ax * ax + ay * ay) - crossStep * crossStep;
+            float multiplier = gradientFunction_->GetMultiplier() * indexScale;
+            steps.rootScale = multiplier;
+            steps.linear = (px * centerX + py * centerY) * multiplier - distance1_ * indexScale;
+            steps.linearStep = (ax * centerX + ay * centerY) * multiplier;
+        }
+        steps.root = quadraticA;
+        steps.rootStep = quadraticB + quadraticC;
+        steps.rootStep2 = 2.0f * quadraticC; // 2: second difference of c * i^2
+        if (concentric) {
+            FillSpan<true>(span, len, steps);
+        } else {
+            FillSpan<false>(span, len, steps);
+        }
+    }
+
+private:
+    /**
+     * @brief The value under the square root at a pixel with its first and constant second differences,
+     * and the LUT index root * rootScale + linear, linear stepping by linearStep.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct RadialSteps {
+        float root;
+        float rootStep;
+        float rootStep2;
+        float rootScale;
+        float linear;
+        float linearStep;
+    };
+
+    static inline void CopyColor(Rgba8T* dst, const Rgba8T& src)
+    {
+        dst->red = src.red;
+        dst->green = src.green;
+        dst->blue = src.blue;
+        dst->alpha = src.alpha;
+    }
+
+    template <bool CONCENTRIC>
+    void FillSpan(Rgba8T* span, uint32_t len, RadialSteps& steps)
+    {
+        const Rgba8T* colors = &(*colorFunction_)[0];
+        int32_t maxIndex = static_cast<int32_t>(colorFunction_->GetSize()) - 1;
+#ifdef ARM_NEON_OPT
+        if (len >= NEON_STEP_4) {
+            FillSpanNeon<CONCENTRIC>(span, len, steps, colors, maxIndex);
+        }
+#endif
+        for (; len; --len, span++) {
+            int32_t index = static_cast<int32_t>(Sqrt(fabsf(steps.root)) * steps.rootScale + steps.linear);
+            index = MATH_MIN(MATH_MAX(index, 0), maxIndex);
+            CopyColor(span, colors[index]);
+            steps.root += steps.rootStep;
+            steps.rootStep += steps.rootStep2;
+            if (!CONCENTRIC) {
+                steps.linear += steps.linearStep;
+            }
+        }
+    }
+
+#ifdef ARM_NEON_OPT
+    /**
+     * @brief Fill four pixels at a time, the lanes stepping by four pixels, and leave the remaining pixels
+     * and their steps for the scalar loop.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <bool CONCENTRIC>
+    static void FillSpanNeon(Rgba8T*& span, uint32_t& len, RadialSteps& steps, const Rgba8T* colors,
+                             int32_t maxIndex)
+    {
+        float root[NEON_STEP_4];
+        float rootStep[NEON_STEP_4];
+        float linear[NEON_STEP_4];
+        const float firstRootStep = steps.rootStep;
+        const uint32_t pixels = len & ~(NEON_STEP_4 - 1);
+        for (int32_t i = 0; i < NEON_STEP_4; i++) {
+            root[i] = steps.root;
+            // Four first differences from pixel i
+            rootStep[i] = NEON_STEP_4 * steps.rootStep + 6.0f * steps.rootStep2; // 6: 0 + 1 + 2 + 3
+            linear[i] = steps.linear;
+            steps.root += steps.rootStep;
+            steps.rootStep += steps.rootStep2;
+            steps.linear += steps.linearStep;
+        }
+        float32x4_t rootVector = vld1q_f32(root);
+        float32x4_t rootStepVector = vld1q_f32(rootStep);
+        // 16: four pixels of four second differences
+        const float32x4_t rootStep2Vector = vdupq_n_f32(16.0f * steps.rootStep2);
+        float32x4_t linearVector = vld1q_f32(linear);
+        const float32x4_t linearStepVector = vdupq_n_f32(NEON_STEP_4 * steps.linearStep);
+        const float32x4_t rootScale = vdupq_n_f32(steps.rootScale);
+        const int32x4_t zero = vdupq_n_s32(0);
+        const int32x4_t last = vdupq_n_s32(maxIndex);
+        int32_t index[NEON_STEP_4];
+        for (; len >= NEON_STEP_4; len -= NEON_STEP_4) {
+            float32x4_t position = vmlaq_f32(linearVector, NeonSqrt(vabsq_f32(rootVector)), rootScale);
+            vst1q_s32(index, vminq_s32(vmaxq_s32(vcvtq_s32_f32(position), zero), last));
+            for (int32_t i = 0; i < NEON_STEP_4; i++) {
+                CopyColor(span++, colors[index[i]]);
+            }
+            rootVector = vaddq_f32(rootVector, rootStepVector);
+            rootStepVector = vaddq_f32(rootStepVector, rootStep2Vector);
+            if (!CONCENTRIC) {
+                linearVector = vaddq_f32(linearVector, linearStepVector);
+            }
+        }
+        // The first lanes hold the next pixel
+        vst1q_f32(root, rootVector);
+        vst1q_f32(linear, linearVector);
+        steps.root = root[0];
+        steps.rootStep = firstRootStep + pixels * steps.rootStep2;
+        steps.linear = linear[0];
+    }
+#endif
+
+    FillInterpolator* interpolator_;
+    GradientRadialCalculate* gradientFunction_;
+    FillGradientLut* colorFunction_;
+    int32_t distance1_;
+    int32_t distance2_;
+#endif
+};
+
+/**
+ * @brief Sweep gradient scanline fill.
+ * The gradient space position is an affine function of x along a scanline, so it is transformed at both ends
+ * of the span once and stepped, the angles coming from the polynomial of FastAtan2F, four at a time with NEON.
+ * @since 1.0
+ * @version 1.0
+ */
+template <>
+class FillGradientSpan<GradientSweepCalculate> : public SpanBase {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    FillGradientSpan(FillInterpolator& inter, GradientSweepCalculate& gradientFunction,
+                     FillGradientLut& colorFunction, float, float)
+        : interpolator_(&inter),
+          gradientFunction_(&gradientFunction),
+          colorFunction_(&colorFunction) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        if (len == 0) {
+            return;
+        }
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        interpolator_->TransformSubpixel(x, y, &x1, &y1);
+        interpolator_->TransformSubpixel(x + static_cast<int32_t>(len), y, &x2, &y2);
+        // The angle does not depend on the scale, so the positions stay in 1 / SUBPIXEL_SCALE pixels
+        float positionX = static_cast<float>(x1);
+        float positionY = static_cast<float>(y1);
+        const float stepX = static_cast<float>(x2 - x1) / len;
+        const float stepY = static_cast<float>(y2 - y1) / len;
+        const Rgba8T* colors = &(*colorFunction_)[0];
+        int32_t size = static_cast<int32_t>(colorFunction_->GetSize());
+#ifdef ARM_NEON_OPT
+        if (len >= NEON_STEP_4) {
+            FillSpanNeon(span, len, positionX, positionY, stepX, stepY, colors, size);
+        }
+#endif
+        for (; len; --len, span++) {
+            CopyColor(span, colors[gradientFunction_->AngleToIndex(FastAtan2F(positionY, positionX), size)]);
+            positionX += stepX;
+            positionY += stepY;
+        }
+    }
+
+private:
+    static inline void CopyColor(Rgba8T* dst, const Rgba8T& src)
+    {
+        dst->red = src.red;
+        dst->green = src.green;
+        dst->blue = src.blue;
+        dst->alpha = src.alpha;
+    }
+
+#ifdef ARM_NEON_OPT
+    /**
+     * @brief Fill four pixels at a time, the lanes stepping by four pixels, and leave the remaining pixels
+     * and their positions for the scalar loop.
+     * @since 1.0
+     * @version 1.0
+     */
+    void FillSpanNeon(Rgba8T*& span, uint32_t& len, float& positionX, float& positionY, float stepX, float stepY,
+                      const Rgba8T* colors, int32_t size) const
+    {
+        float lanesX[NEON_STEP_4];
+        float lanesY[NEON_STEP_4];
+        for (int32_t i = 0; i < NEON_STEP_4; i++) {
+            lanesX[i] = positionX + i * stepX;
+            lanesY[i] = positionY + i * stepY;
+        }
+        float32x4_t vectorX = vld1q_f32(lanesX);
+        float32x4_t vectorY = vld1q_f32(lanesY);
+        const float32x4_t stepVectorX = vdupq_n_f32(NEON_STEP_4 * stepX);
+        const float32x4_t stepVectorY = vdupq_n_f32(NEON_STEP_4 * stepY);
+        const float32x4_t startAngle = vdupq_n_f32(gradientFunction_->GetStartAngle());
+        const float32x4_t circle = vdupq_n_f32(static_cast<float>(2 * UI_PI)); // 2: a circle
+        const float32x4_t indexScale = vdupq_n_f32(gradientFunction_->GetIndexScale() * size);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const int32x4_t last = vdupq_n_s32(size - 1);
+        int32_t index[NEON_STEP_4];
+        for (; len >= NEON_STEP_4; len -= NEON_STEP_4) {
+            // From -3 pi to pi, as AngleToIndex
+            float32x4_t angle = vsubq_f32(NeonAtan2(vectorY, vectorX), startAngle);
+            angle = vbslq_f32(vcltq_f32(angle, zero), vaddq_f32(angle, circle), angle);
+            angle = vbslq_f32(vcltq_f32(angle, zero), vaddq_f32(angle, circle), angle);
+            vst1q_s32(index, vminq_s32(vcvtq_s32_f32(vmulq_f32(angle, indexScale)), last));
+            for (int32_t i = 0; i < NEON_STEP_4; i++) {
+                CopyColor(span++, colors[index[i]]);
+            }
+            vectorX = vaddq_f32(vectorX, stepVectorX);
+            vectorY = vaddq_f32(vectorY, stepVectorY);
+        }
+        // The first lanes hold the next pixel
+        vst1q_f32(lanesX, vectorX);
+        vst1q_f32(lanesY, vectorY);
+        positionX = lanesX[0];
+        positionY = lanesY[0];
+    }
+#endif
+
+    FillInterpolator* interpolator_;
+    GradientSweepCalculate* gradientFunction_;
+    FillGradientLut* colorFunction_;
+#endif
+};
 } // namespace OHOS
 #endif
@@ -27,6 +27,7 @@
 #include "gfx_utils/diagram/vertexprimitive/geometry_dda_line.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_range_adapter.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
 #include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
 #include "gfx_utils/vector.h"
 namespace OHOS {
@@ -42,7 +43,55 @@ const uint16_t COLOR_LUT_SIZE = 512;
 class FillGradientLut {
 #if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
 public:
-    FillGradientLut() : colorProfile_(COLOR_PROFILE_SIZE), colorType_(COLOR_LUT_SIZE), colorLutSize_(COLOR_LUT_SIZE) {}
+    FillGradientLut()
+        : colorProfile_(COLOR_PROFILE_SIZE),
+          colorType_(COLOR_LUT_SIZE),
+          colorLutSize_(COLOR_LUT_SIZE),
+          colors_(colorType_.Data()),
+          cached_(false),
+          premultiplied_(false) {}
+
+    FillGradientLut(const FillGradientLut& lut)
+        : colorProfile_(lut.colorProfile_),
+          colorType_(lut.colorType_),
+          colorLutSize_(lut.colorLutSize_),
+          colors_(colorType_.Data()),
+          cached_(lut.cached_),
+          premultiplied_(lut.premultiplied_)
+    {
+        if (cached_) {
+            colors_ = lut.colors_;
+            GradientLutCache::GetInstance()->Retain(colors_);
+        }
+    }
+
+    const FillGradientLut& operator=(const FillGradientLut& lut)
+    {
+        if (this == &lut) {
+            return *this;
+        }
+        // The own table may be reallocated by the copy, so colors_ is only pointed at it afterwards.
+        // A shared table is retained before the old one is released, in case both are the same.
+        colorProfile_ = lut.colorProfile_;
+        colorType_ = lut.colorType_;
+        colorLutSize_ = lut.colorLutSize_;
+        premultiplied_ = lut.premultiplied_;
+        if (lut.cached_) {
+            GradientLutCache::GetInstance()->Retain(lut.colors_);
+        }
+        ReleaseColors();
+        if (lut.cached_) {
+            colors_ = lut.colors_;
+            cached_ = true;
+        }
+        return *this;
+    }
+
+    ~FillGradientLut()
+    {
+        ReleaseColors();
+    }
+
     /**
      * @brief Remove all colors
      * @since 1.0
@@ -65,10 +114,28 @@ public:
         colorProfile_.PushBack(ColorPoint(offset, color));
     }
 
+    /**
+     * @brief Build the table with premultiplied alpha from the next BuildLut on,
+     * interpolating the premultiplied colors of the stops, so that the spans can be blended
+     * as premultiplied colors without multiplying every pixel by its alpha.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetPremultiplied(bool premultiplied)
+    {
+        premultiplied_ = premultiplied;
+    }
+
+    bool IsPremultiplied() const
+    {
+        return premultiplied_;
+    }
+
     /**
      * @brief Building a color_typ array from gradient colors
      * Array length 0-255
-     * The contents of the array are distributed on the array according to the gradient color
+     * The contents of the array are distributed on the array according to the gradient color.
+     * Identical gradients share the table kept by GradientLutCache, which is only built on a miss.
      * @since 1.0
      * @version 1.0
      */
@@ -80,38 +147,32 @@ public:
         QuickSort(colorProfile_, OffsetLess);
         colorProfile_.ReSize(RemoveDuplicates(colorProfile_, OffsetEqual));
         if (colorProfile_.Size() > 1) {
-            uint32_t index;
-            uint32_t start = static_cast<uint32_t>(colorProfile_[0].offset * colorLutSize_);
-            uint32_t end;
-            Rgba8T color = colorProfile_[0].color;
-
             /*
-             * Assign initial color calculation to colorprofile [0]
+             * The key of the table: the flags, then the index and the color of every stop
              */
-            for (index = 0; index < start; index++) {
-                colorType_[index] = color;
+            uint32_t keySize = LUT_KEY_STOPS + colorProfile_.Size() * LUT_KEY_STOP_WORDS;
+            if (lutKey_.GetSize() < keySize) {
+                lutKey_.Resize(keySize);
             }
-            /*
-             * From 1 to colorprofile Interpolation color calculation between size ()
-             */
-            for (index = 1; index < colorProfile_.Size(); index++) {
-                end = static_cast<uint32_t>(colorProfile_[index].offset * colorLutSize_);
-                ColorInterpolator ci(colorProfile_[index - 1].color,
-                                     colorProfile_[index].color,
-                                     end - start + 1);
-                while (start < end) {
-                    colorType_[start] = ci.GetColor();
-                    ++ci;
-                    ++start;
-                }
+            uint32_t* key = lutKey_.Data();
+            if (key == nullptr) {
+                return;
             }
-            color = colorProfile_.End()->color;
-            /*
-             * Give end color to colorprofile last
-             */
-            for (; end < colorType_.GetSize(); end++) {
-                color = colorProfile_.End()->color;
-                colorType_[end] = color;
+            key[0] = premultiplied_ ? LUT_KEY_PREMULTIPLIED : 0;
+            for (uint32_t index = 0; index < colorProfile_.Size(); index++) {
+                const ColorPoint& point = colorProfile_[index];
+                uint32_t* stopKey = key + LUT_KEY_STOPS + index * LUT_KEY_STOP_WORDS;
+                stopKey[0] = static_cast<uint32_t>(point.offset * colorLutSize_);
+                stopKey[1] = point.color.red | (point.color.green << 8) | // 8: green
+                    (point.color.blue << 16) | (static_cast<uint32_t>(point.color.alpha) << 24); // 16, 24: blue, alpha
+            }
+            ReleaseColors();
+            const Rgba8T* colors = GradientLutCache::GetInstance()->Acquire(key, keySize, colorLutSize_, BuildColors);
+            if (colors != nullptr) {
+                colors_ = colors;
+                cached_ = true;
+            } else {
+                BuildColors(key, keySize, colorType_.Data(), colorLutSize_);
             }
         }
     }
@@ -129,9 +190,112 @@ public:
      */
     const Rgba8T& operator[](uint32_t i) const
     {
-        return colorType_[i];
+        return colors_[i];
     }
 private:
+    /**
+     * @brief The key of a table is the word of its flags, followed by LUT_KEY_STOP_WORDS words per stop.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum LutKeyScale {
+        LUT_KEY_PREMULTIPLIED = 1,
+        LUT_KEY_STOPS = 1,
+        LUT_KEY_STOP_WORDS = 2
+    };
+
+    /**
+     * @brief Go back to the own table, dropping the reference to a shared one.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ReleaseColors()
+    {
+        if (cached_) {
+            GradientLutCache::GetInstance()->Release(colors_);
+            cached_ = false;
+        }
+        colors_ = colorType_.Data();
+    }
+
+    /**
+     * @brief Build a table from the stops of a key, interpolating between them in integers:
+     * the place in a segment of length len weighs the next stop by round(place * 255 / len),
+     * whose numerator and remainder are stepped without any division.
+     * A premultiplied table interpolates the premultiplied colors of the stops.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void BuildColors(const uint32_t* key, uint32_t keySize, Rgba8T* colors, uint32_t lutSize)
+    {
+        if (colors == nullptr || keySize < LUT_KEY_STOPS + LUT_KEY_STOP_WORDS) {
+            return;
+        }
+        bool premultiplied = (key[0] & LUT_KEY_PREMULTIPLIED) != 0;
+        uint32_t numStops = (keySize - LUT_KEY_STOPS) / LUT_KEY_STOP_WORDS;
+        key += LUT_KEY_STOPS;
+        uint32_t start = MATH_MIN(key[0], lutSize);
+        Rgba8T color = KeyColor(key[1], premultiplied);
+        uint32_t index;
+        for (index = 0; index < start; index++) {
+            CopyColor(colors + index, color);
+        }
+        uint32_t end = start;
+        for (uint32_t stop = 1; stop < numStops; stop++) {
+            end = MATH_MIN(key[stop * LUT_KEY_STOP_WORDS], lutSize);
+            Rgba8T nextColor = KeyColor(key[stop * LUT_KEY_STOP_WORDS + 1], premultiplied);
+            // 2: round(place * 255 / len) is (2 * 255 * place + len) / (2 * len)
+            const uint32_t denominator = 2 * (end - start + 1);
+            const uint32_t numeratorStep = 2 * Rgba8T::BASE_MASK;
+            uint32_t weight = 0;
+            uint32_t remainder = end - start + 1;
+            for (; start < end; start++) {
+                colors[start].red = Rgba8T::Lerp(color.red, nextColor.red, weight);
+                colors[start].green = Rgba8T::Lerp(color.green, nextColor.green, weight);
+                colors[start].blue = Rgba8T::Lerp(color.blue, nextColor.blue, weight);
+                colors[start].alpha = Rgba8T::Lerp(color.alpha, nextColor.alpha, weight);
+                if (premultiplied) {
+                    // The rounding must not leave a channel above the alpha
+                    colors[start].red = MATH_MIN(colors[start].red, colors[start].alpha);
+                    colors[start].green = MATH_MIN(colors[start].green, colors[start].alpha);
+                    colors[start].blue = MATH_MIN(colors[start].blue, colors[start].alpha);
+                }
+                remainder += numeratorStep;
+                while (remainder >= denominator) {
+                    remainder -= denominator;
+                    weight++;
+                }
+            }
+            color = nextColor;
+        }
+        /*
+         * Give the color of the last stop to the end of the table
+         */
+        for (; end < lutSize; end++) {
+            CopyColor(colors + end, color);
+        }
+    }
+
+    static inline Rgba8T KeyColor(uint32_t word, bool premultiplied)
+    {
+        // 8, 16, 24: green, blue, alpha
+        Rgba8T color(word & 0xFF, (word >> 8) & 0xFF, (word >> 16) & 0xFF, word >> 24);
+        if (premultiplied) {
+            color.red = Rgba8T::Multiply(color.red, color.alpha);
+            color.green = Rgba8T::Multiply(color.green, color.alpha);
+            color.blue = Rgba8T::Multiply(color.blue, color.alpha);
+        }
+        return color;
+    }
+
+    static inline void CopyColor(Rgba8T* dst, const Rgba8T& src)
+    {
+        dst->red = src.red;
+        dst->green = src.green;
+        dst->blue = src.blue;
+        dst->alpha = src.alpha;
+    }
+
     struct ColorPoint {
         float offset;
         Rgba8T color;
@@ -180,6 +344,11 @@ private:
     Graphic::Vector<ColorPoint> colorProfile_;
     GeometryPlainDataArray<Rgba8T> colorType_;
     uint16_t colorLutSize_;
+    /** The table read, colorType_ or a table shared through GradientLutCache */
+    const Rgba8T* colors_;
+    bool cached_;
+    bool premultiplied_;
+    GeometryPlainDataArray<uint32_t> lutKey_;
 #endif
 };
 } // namespace OHOS
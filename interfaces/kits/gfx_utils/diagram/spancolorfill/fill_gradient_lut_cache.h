@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_gradient_lut_cache.h
+ * @brief Defines the process wide cache of built gradient color tables
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_GRADIENT_LUT_CACHE_H
+#define GRAPHIC_LITE_FILL_GRADIENT_LUT_CACHE_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+#include "gfx_utils/heap_base.h"
+#include "graphic_mutex.h"
+
+namespace OHOS {
+/**
+ * @class GradientLutCache
+ * @brief Keeps the last built gradient color tables, so that widgets drawing the same gradient
+ * every frame share one table instead of building it again.
+ * A table is found by its key, the words describing its stops, and its size.
+ * The tables in use are reference counted, and a miss replaces the least recently used table
+ * no longer in use, or is not cached when every table is in use.
+ * @since 1.0
+ * @version 1.0
+ */
+class GradientLutCache : public HeapBase {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    enum GradientLutCacheScale {
+        GRADIENT_LUT_CACHE_ENTRIES = 16
+    };
+
+    /**
+     * @brief Builds the lutSize colors of a table from its key.
+     * @since 1.0
+     * @version 1.0
+     */
+    using BuildFunction = void (*)(const uint32_t* key, uint32_t keySize, Rgba8T* colors, uint32_t lutSize);
+
+    static GradientLutCache* GetInstance();
+
+    /**
+     * @brief Get the table of the key, building it with build on a miss, and hold a reference to it.
+     * @return The colors of the table, to be released with Release,
+     * or nullptr when it cannot be cached and has to be built by the caller.
+     * @since 1.0
+     * @version 1.0
+     */
+    const Rgba8T* Acquire(const uint32_t* key, uint32_t keySize, uint32_t lutSize, BuildFunction build);
+
+    /**
+     * @brief Hold one more reference to a table got from Acquire.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Retain(const Rgba8T* colors);
+
+    /**
+     * @brief Drop a reference to a table got from Acquire, the table stays cached for the next Acquire.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Release(const Rgba8T* colors);
+
+    uint32_t GetNumHits() const
+    {
+        return numHits_;
+    }
+
+    uint32_t GetNumMisses() const
+    {
+        return numMisses_;
+    }
+
+private:
+    GradientLutCache() : useClock_(0), numHits_(0), numMisses_(0) {}
+    ~GradientLutCache() {}
+    GradientLutCache(const GradientLutCache&);
+    const GradientLutCache& operator=(const GradientLutCache&);
+
+    struct CacheEntry {
+        CacheEntry() : hash(0), keySize(0), lutSize(0), refCount(0), lastUse(0) {}
+        GeometryPlainDataArray<uint32_t> key;
+        GeometryPlainDataArray<Rgba8T> colors;
+        uint32_t hash;
+        uint32_t keySize;
+        /** 0 for an empty entry */
+        uint32_t lutSize;
+        uint32_t refCount;
+        uint32_t lastUse;
+    };
+
+    static uint32_t Hash(const uint32_t* key, uint32_t keySize, uint32_t lutSize);
+    CacheEntry* FindEntry(const Rgba8T* colors);
+
+    CacheEntry entries_[GRADIENT_LUT_CACHE_ENTRIES];
+    GraphicMutex mutex_;
+    uint32_t useClock_;
+    uint32_t numHits_;
+    uint32_t numMisses_;
+#endif
+};
+} // namespace OHOS
+#endif
@@ -96,26 +96,29 @@ public:
      */
     void Begin(float x, float y, uint32_t len)
     {
-        float tx;
-        float ty;
-
-        tx = x;
-        ty = y;
-
-        transType_->Transform(&tx, &ty);
-        int32_t x1 = MATH_ROUND32(tx * SUBPIXEL_SCALE);
-        int32_t y1 = MATH_ROUND32(ty * SUBPIXEL_SCALE);
-
-        tx = x + len;
-        ty = y;
-        transType_->Transform(&tx, &ty);
-        int32_t x2 = MATH_ROUND32(tx * SUBPIXEL_SCALE);
-        int32_t y2 = MATH_ROUND32(ty * SUBPIXEL_SCALE);
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        TransformSubpixel(x, y, &x1, &y1);
+        TransformSubpixel(x + len, y, &x2, &y2);
 
         dda2LineInterpolatorX_ = GeometryDdaLine(x1, x2, len);
         dda2LineInterpolatorY_ = GeometryDdaLine(y1, y2, len);
     }
 
+    /**
+     * @brief Transform a point, the result being in 1 / SUBPIXEL_SCALE pixels as the interpolated coordinates
+     * @since 1.0
+     * @version 1.0
+     */
+    void TransformSubpixel(float x, float y, int32_t* tx, int32_t* ty) const
+    {
+        transType_->Transform(&x, &y);
+        *tx = MATH_ROUND32(x * SUBPIXEL_SCALE);
+        *ty = MATH_ROUND32(y * SUBPIXEL_SCALE);
+    }
+
     /**
      * @brief Overloading + + operators
      */
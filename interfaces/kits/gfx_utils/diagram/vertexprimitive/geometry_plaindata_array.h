@@ -62,7 +62,8 @@ public:
     GeometryPlainDataArray(const SelfType& podArray)
         : data_(GeometryArrayAllocator<T>::Allocate(podArray.size_)), size_(podArray.size_)
     {
-        if (memcpy_s(data_, sizeof(T) * size_, podArray.data_, sizeof(T) * size_) != EOK) {
+        // An empty array has no data to copy from
+        if (size_ != 0 && memcpy_s(data_, sizeof(T) * size_, podArray.data_, sizeof(T) * size_) != EOK) {
             GRAPHIC_LOGE("GeometryPlainDataArray fail");
         }
     }
@@ -70,7 +71,7 @@ public:
     const SelfType& operator=(const SelfType& podArray)
     {
         Resize(podArray.GetSize());
-        if (memcpy_s(data_, sizeof(T) * size_, podArray.data_, sizeof(T) * size_) != EOK) {
+        if (size_ != 0 && memcpy_s(data_, sizeof(T) * size_, podArray.data_, sizeof(T) * size_) != EOK) {
             GRAPHIC_LOGE("GeometryPlainDataArray fail");
         }
         return *this;
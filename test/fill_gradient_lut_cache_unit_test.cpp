@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+#include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const uint32_t LUT_SIZE = 16;
+    const uint32_t KEY_SIZE = 3;
+    const uint32_t ENTRIES = GradientLutCache::GRADIENT_LUT_CACHE_ENTRIES;
+    // Keys of this test start at KEY_BASE, so they never match the key of a FillGradientLut
+    const uint32_t KEY_BASE = 0xC0DE0000;
+    const uint32_t MAX_STOPS = 6;
+    // The rounding of the premultiplied stops, of the weight and of the blend add up to 1.5
+    const float PREMULTIPLIED_TOLERANCE = 1.5f;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    uint32_t g_numBuilds = 0;
+
+    void FillWithKey(const uint32_t* key, uint32_t keySize, Rgba8T* colors, uint32_t lutSize)
+    {
+        g_numBuilds++;
+        for (uint32_t i = 0; i < lutSize; i++) {
+            colors[i].red = static_cast<uint8_t>(key[1]);
+            colors[i].green = static_cast<uint8_t>(key[1] >> 8); // 8: second byte
+            colors[i].blue = static_cast<uint8_t>(i);
+            colors[i].alpha = static_cast<uint8_t>(keySize);
+        }
+    }
+
+    const Rgba8T* AcquireKey(uint32_t id)
+    {
+        uint32_t key[KEY_SIZE] = {KEY_BASE, id, 0};
+        return GradientLutCache::GetInstance()->Acquire(key, KEY_SIZE, LUT_SIZE, FillWithKey);
+    }
+
+    // Acquire and release ENTRIES other keys, so that every table no longer in use is replaced
+    void EvictUnused(uint32_t firstId)
+    {
+        for (uint32_t i = 0; i < ENTRIES; i++) {
+            const Rgba8T* colors = AcquireKey(firstId + i);
+            if (colors != nullptr) {
+                GradientLutCache::GetInstance()->Release(colors);
+            }
+        }
+    }
+
+    void BuildRedToBlue(FillGradientLut& lut)
+    {
+        lut.RemoveAll();
+        lut.AddColor(0, Rgba8T(255, 0, 0, 255)); // 255: red
+        lut.AddColor(1, Rgba8T(0, 0, 255, 255)); // 255: blue
+        lut.BuildLut();
+    }
+
+    void BuildGreenToBlack(FillGradientLut& lut)
+    {
+        lut.RemoveAll();
+        lut.AddColor(0, Rgba8T(0, 255, 0, 255)); // 255: green
+        lut.AddColor(1, Rgba8T(0, 0, 0, 255)); // 255: opaque
+        lut.BuildLut();
+    }
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    /*
+     * Random colors on sorted offsets of distinct indexes, the first and last away from the ends of the table.
+     * @return The number of stops.
+     */
+    uint32_t RandomStops(uint32_t& seed, uint32_t numStops, float* offsets, Rgba8T* stops)
+    {
+        uint32_t lutIndex = NextRandom(seed) % 40; // 40: the first index up to 39
+        for (uint32_t i = 0; i < numStops; i++) {
+            offsets[i] = (lutIndex + 0.5f) / COLOR_LUT_SIZE; // 0.5: the middle of the entry
+            lutIndex += 1 + NextRandom(seed) % 80; // 80: up to 80 entries between stops
+            uint32_t word = NextRandom(seed) ^ (NextRandom(seed) << 8); // 8: fill the high byte
+            stops[i] = Rgba8T(word & 0xFF, (word >> 8) & 0xFF, (word >> 16) & 0xFF, word >> 24); // 8, 16, 24: bytes
+        }
+        return numStops;
+    }
+
+    // The table of sorted stops of distinct indexes, built with ColorInterpolator as before the cache
+    void ReferenceLut(const float* offsets, const Rgba8T* stops, uint32_t numStops, Rgba8T* colors)
+    {
+        uint32_t start = static_cast<uint32_t>(offsets[0] * COLOR_LUT_SIZE);
+        uint32_t index;
+        for (index = 0; index < start; index++) {
+            colors[index] = stops[0];
+        }
+        uint32_t end = start;
+        for (index = 1; index < numStops; index++) {
+            end = static_cast<uint32_t>(offsets[index] * COLOR_LUT_SIZE);
+            ColorInterpolator ci(stops[index - 1], stops[index], end - start + 1);
+            for (; start < end; start++) {
+                colors[start] = ci.GetColor();
+                ++ci;
+            }
+        }
+        for (; end < COLOR_LUT_SIZE; end++) {
+            colors[end] = stops[numStops - 1];
+        }
+    }
+
+    // The largest distance of a channel of the table from the exact interpolation of the premultiplied stops
+    float PremultipliedError(const FillGradientLut& lut, const float* offsets, const Rgba8T* stops, uint32_t numStops)
+    {
+        float maxError = 0.0f;
+        uint32_t start = static_cast<uint32_t>(offsets[0] * COLOR_LUT_SIZE);
+        for (uint32_t stop = 1; stop < numStops; stop++) {
+            uint32_t end = static_cast<uint32_t>(offsets[stop] * COLOR_LUT_SIZE);
+            const Rgba8T& from = stops[stop - 1];
+            const Rgba8T& to = stops[stop];
+            for (uint32_t place = 0; start + place < end; place++) {
+                float weight = static_cast<float>(place) / (end - start + 1);
+                float alpha = from.alpha + (to.alpha - from.alpha) * weight;
+                const uint8_t fromChannels[] = {from.red, from.green, from.blue};
+                const uint8_t toChannels[] = {to.red, to.green, to.blue};
+                const Rgba8T& color = lut[start + place];
+                const uint8_t channels[] = {color.red, color.green, color.blue};
+                maxError = MATH_MAX(maxError, fabsf(color.alpha - alpha));
+                for (uint32_t i = 0; i < 3; i++) { // 3: red, green and blue
+                    float fromValue = fromChannels[i] * from.alpha / 255.0f; // 255: the largest alpha
+                    float toValue = toChannels[i] * to.alpha / 255.0f; // 255: the largest alpha
+                    maxError = MATH_MAX(maxError, fabsf(channels[i] - (fromValue + (toValue - fromValue) * weight)));
+                }
+            }
+            start = end;
+        }
+        return maxError;
+    }
+
+    bool SameColors(const FillGradientLut& lut, const Rgba8T* expect, uint32_t size)
+    {
+        for (uint32_t i = 0; i < size; i++) {
+            if (lut[i].red != expect[i].red || lut[i].green != expect[i].green ||
+                lut[i].blue != expect[i].blue || lut[i].alpha != expect[i].alpha) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+class GradientLutCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: GradientLutCacheAcquire_001
+ * @tc.desc: Verify Acquire builds a table on a miss and shares it on a hit.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheAcquire_001, TestSize.Level0)
+{
+    GradientLutCache* cache = GradientLutCache::GetInstance();
+    uint32_t hits = cache->GetNumHits();
+    uint32_t misses = cache->GetNumMisses();
+    uint32_t builds = g_numBuilds;
+
+    const Rgba8T* first = AcquireKey(1);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(cache->GetNumMisses(), misses + 1);
+    EXPECT_EQ(g_numBuilds, builds + 1);
+    EXPECT_EQ(first[0].red, 1);
+    EXPECT_EQ(first[LUT_SIZE - 1].blue, LUT_SIZE - 1);
+
+    const Rgba8T* second = AcquireKey(1);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(cache->GetNumHits(), hits + 1);
+    EXPECT_EQ(g_numBuilds, builds + 1);
+
+    const Rgba8T* other = AcquireKey(2);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other, first);
+    EXPECT_EQ(other[0].red, 2);
+    EXPECT_EQ(cache->GetNumMisses(), misses + 2);
+
+    cache->Release(first);
+    cache->Release(second);
+    cache->Release(other);
+}
+
+/**
+ * @tc.name: GradientLutCacheAcquire_002
+ * @tc.desc: Verify Acquire rejects an empty key or table.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheAcquire_002, TestSize.Level0)
+{
+    uint32_t key[KEY_SIZE] = {KEY_BASE, 1, 0};
+    GradientLutCache* cache = GradientLutCache::GetInstance();
+    EXPECT_EQ(cache->Acquire(nullptr, KEY_SIZE, LUT_SIZE, FillWithKey), nullptr);
+    EXPECT_EQ(cache->Acquire(key, 0, LUT_SIZE, FillWithKey), nullptr);
+    EXPECT_EQ(cache->Acquire(key, KEY_SIZE, 0, FillWithKey), nullptr);
+    EXPECT_EQ(cache->Acquire(key, KEY_SIZE, LUT_SIZE, nullptr), nullptr);
+}
+
+/**
+ * @tc.name: GradientLutCacheEvict_001
+ * @tc.desc: Verify a released table is replaced once enough other tables are acquired.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheEvict_001, TestSize.Level0)
+{
+    GradientLutCache* cache = GradientLutCache::GetInstance();
+    const Rgba8T* colors = AcquireKey(10); // 10: a key of this case
+    ASSERT_NE(colors, nullptr);
+    cache->Release(colors);
+
+    // Released but still cached, the next Acquire is a hit
+    uint32_t builds = g_numBuilds;
+    colors = AcquireKey(10); // 10: a key of this case
+    EXPECT_EQ(g_numBuilds, builds);
+    cache->Release(colors);
+
+    EvictUnused(100); // 100: the first key used to evict
+    builds = g_numBuilds;
+    colors = AcquireKey(10); // 10: a key of this case
+    ASSERT_NE(colors, nullptr);
+    EXPECT_EQ(g_numBuilds, builds + 1);
+    cache->Release(colors);
+}
+
+/**
+ * @tc.name: GradientLutCacheEvict_002
+ * @tc.desc: Verify tables in use are never replaced, and Acquire fails when every table is in use.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheEvict_002, TestSize.Level0)
+{
+    GradientLutCache* cache = GradientLutCache::GetInstance();
+    const Rgba8T* held[ENTRIES];
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        held[i] = AcquireKey(200 + i); // 200: the first key of this case
+        ASSERT_NE(held[i], nullptr);
+    }
+    EXPECT_EQ(AcquireKey(300), nullptr); // 300: a key not cached
+
+    // Every table kept its colors
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        EXPECT_EQ(held[i][0].red, static_cast<uint8_t>(200 + i)); // 200: the first key of this case
+    }
+
+    cache->Release(held[0]);
+    const Rgba8T* colors = AcquireKey(300); // 300: a key not cached
+    EXPECT_EQ(colors, held[0]);
+    for (uint32_t i = 1; i < ENTRIES; i++) {
+        cache->Release(held[i]);
+    }
+    cache->Release(colors);
+}
+
+/**
+ * @tc.name: GradientLutCacheShare_001
+ * @tc.desc: Verify identical gradients share one table, which survives a copy of the gradient.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheShare_001, TestSize.Level0)
+{
+    FillGradientLut* lut = new FillGradientLut();
+    BuildRedToBlue(*lut);
+    FillGradientLut same;
+    BuildRedToBlue(same);
+    EXPECT_EQ(&(*lut)[0], &same[0]);
+
+    Rgba8T expect[COLOR_LUT_SIZE];
+    for (uint32_t i = 0; i < COLOR_LUT_SIZE; i++) {
+        expect[i] = (*lut)[i];
+    }
+    EXPECT_EQ(expect[0].red, 255); // 255: red
+    EXPECT_GT(expect[COLOR_LUT_SIZE - 1].blue, expect[0].blue);
+
+    FillGradientLut copy(*lut);
+    delete lut;
+    BuildGreenToBlack(same);
+    EvictUnused(400); // 400: the first key used to evict
+    EXPECT_TRUE(SameColors(copy, expect, COLOR_LUT_SIZE));
+}
+
+/**
+ * @tc.name: GradientLutBuild_001
+ * @tc.desc: Verify the integer build of a table matches the ColorInterpolator build on random gradients.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutBuild_001, TestSize.Level0)
+{
+    float offsets[MAX_STOPS];
+    Rgba8T stops[MAX_STOPS];
+    static Rgba8T expect[COLOR_LUT_SIZE];
+    uint32_t seed = 23; // 23: seed
+    for (uint32_t gradient = 0; gradient < 200; gradient++) { // 200: gradients
+        uint32_t numStops = RandomStops(seed, 2 + gradient % (MAX_STOPS - 1), offsets, stops); // 2: the fewest stops
+        ReferenceLut(offsets, stops, numStops, expect);
+
+        FillGradientLut lut;
+        for (uint32_t i = numStops; i > 0; i--) {
+            lut.AddColor(offsets[i - 1], stops[i - 1]);
+        }
+        lut.BuildLut();
+        ASSERT_TRUE(SameColors(lut, expect, COLOR_LUT_SIZE)) << "gradient " << gradient;
+    }
+}
+
+/**
+ * @tc.name: GradientLutPremultiplied_001
+ * @tc.desc: Verify the premultiplied tables keep every channel within its alpha and near the exact interpolation.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutPremultiplied_001, TestSize.Level0)
+{
+    float offsets[MAX_STOPS];
+    Rgba8T stops[MAX_STOPS];
+    uint32_t seed = 24; // 24: seed
+    for (uint32_t gradient = 0; gradient < 200; gradient++) { // 200: gradients
+        uint32_t numStops = RandomStops(seed, 2 + gradient % (MAX_STOPS - 1), offsets, stops); // 2: the fewest stops
+        FillGradientLut lut;
+        lut.SetPremultiplied(true);
+        for (uint32_t i = 0; i < numStops; i++) {
+            lut.AddColor(offsets[i], stops[i]);
+        }
+        lut.BuildLut();
+        for (uint32_t i = 0; i < COLOR_LUT_SIZE; i++) {
+            ASSERT_LE(lut[i].red, lut[i].alpha) << "gradient " << gradient << " at " << i;
+            ASSERT_LE(lut[i].green, lut[i].alpha) << "gradient " << gradient << " at " << i;
+            ASSERT_LE(lut[i].blue, lut[i].alpha) << "gradient " << gradient << " at " << i;
+        }
+        float error = PremultipliedError(lut, offsets, stops, numStops);
+        EXPECT_LE(error, PREMULTIPLIED_TOLERANCE) << "gradient " << gradient;
+    }
+}
+
+/**
+ * @tc.name: GradientLutPremultiplied_002
+ * @tc.desc: Verify the straight and premultiplied tables of the same stops are cached apart, and copies keep the mode.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutPremultiplied_002, TestSize.Level0)
+{
+    FillGradientLut straight;
+    straight.AddColor(0, Rgba8T(255, 128, 0, 255)); // 255, 128, 0: orange, 255: opaque
+    straight.AddColor(1, Rgba8T(0, 0, 255, 0)); // 255: blue, 0: transparent
+    FillGradientLut premultiplied(straight);
+    premultiplied.SetPremultiplied(true);
+    straight.BuildLut();
+    premultiplied.BuildLut();
+    EXPECT_FALSE(straight.IsPremultiplied());
+    EXPECT_TRUE(premultiplied.IsPremultiplied());
+    EXPECT_NE(&straight[0], &premultiplied[0]);
+
+    // Three quarters into a fade to transparent blue, only the straight colors are more blue than opaque
+    const uint32_t place = COLOR_LUT_SIZE * 3 / 4; // 3 / 4: three quarters
+    EXPECT_GT(straight[place].blue, straight[place].alpha);
+    EXPECT_LE(premultiplied[place].blue, premultiplied[place].alpha);
+
+    FillGradientLut copy(premultiplied);
+    EXPECT_TRUE(copy.IsPremultiplied());
+    copy.BuildLut();
+    EXPECT_EQ(&copy[0], &premultiplied[0]);
+}
+
+/**
+ * @tc.name: GradientLutCacheShare_002
+ * @tc.desc: Verify a shared table survives the assignment of the gradient, and the own table is copied.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GradientLutCacheTest, GradientLutCacheShare_002, TestSize.Level0)
+{
+    FillGradientLut* lut = new FillGradientLut();
+    BuildRedToBlue(*lut);
+    Rgba8T expect[COLOR_LUT_SIZE];
+    for (uint32_t i = 0; i < COLOR_LUT_SIZE; i++) {
+        expect[i] = (*lut)[i];
+    }
+    FillGradientLut assigned;
+    assigned = *lut;
+    assigned = assigned;
+    delete lut;
+    EvictUnused(500); // 500: the first key used to evict
+    EXPECT_TRUE(SameColors(assigned, expect, COLOR_LUT_SIZE));
+
+    // With every table in use, a new gradient builds its own table, which the assignment copies
+    const Rgba8T* held[ENTRIES];
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        held[i] = AcquireKey(600 + i); // 600: the first key held
+    }
+    FillGradientLut own;
+    BuildGreenToBlack(own);
+    for (uint32_t i = 0; i < COLOR_LUT_SIZE; i++) {
+        expect[i] = own[i];
+    }
+    EXPECT_EQ(expect[0].green, 255); // 255: green
+    assigned = own;
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        if (held[i] != nullptr) {
+            GradientLutCache::GetInstance()->Release(held[i]);
+        }
+    }
+    EXPECT_NE(&assigned[0], &own[0]);
+    EXPECT_TRUE(SameColors(assigned, expect, COLOR_LUT_SIZE));
+}
+} // namespace OHOS
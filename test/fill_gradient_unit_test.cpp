@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace {
+    const int32_t MAX_SPAN = 400;
+    const int32_t HEIGHT = 256;
+    /*
+     * The LUT entries a pixel of FillGradientSpan may differ by from FillGradient, from the fixed point steps,
+     * besides the entries of one 1 / GRADIENT_SUBPIXEL_SCALE pixel of the coordinates of FillGradient.
+     */
+    const int32_t INDEX_TOLERANCE = 1;
+    // The same for the radial gradients, whose square roots are approximated
+    const int32_t RADIAL_INDEX_TOLERANCE = 2;
+    // The same for the sweep gradients, away from the center where a subpixel spans many angles
+    const int32_t SWEEP_INDEX_TOLERANCE = 2;
+    const float SWEEP_CENTER_RADIUS = 8.0f;
+    const float SWEEP_CENTER_X = 128.0f;
+    const float SWEEP_CENTER_Y = 120.0f;
+
+    // A LUT whose colors differ along it, so that a color tells its index within a few entries
+    void BuildTestLut(FillGradientLut& lut)
+    {
+        lut.RemoveAll();
+        lut.AddColor(0.0f, Rgba8T(0, 255, 10, 255));   // 255, 10: green and blue
+        lut.AddColor(0.5f, Rgba8T(255, 128, 200, 128)); // 255, 128, 200, 128: red, green, blue and alpha
+        lut.AddColor(1.0f, Rgba8T(30, 0, 255, 0));      // 30, 255: red and blue
+        lut.BuildLut();
+    }
+
+    bool SameColor(const Rgba8T& a, const Rgba8T& b)
+    {
+        return a.red == b.red && a.green == b.green && a.blue == b.blue && a.alpha == b.alpha;
+    }
+
+    // The least distance between the LUT entries of two colors, or INT32_MAX when one is not in the LUT
+    int32_t IndexDistance(FillGradientLut& lut, const Rgba8T& a, const Rgba8T& b)
+    {
+        int32_t size = static_cast<int32_t>(lut.GetSize());
+        int32_t distance = INT32_MAX;
+        for (int32_t i = 0; i < size; i++) {
+            if (!SameColor(lut[i], a)) {
+                continue;
+            }
+            for (int32_t k = 0; k < size; k++) {
+                if (SameColor(lut[k], b)) {
+                    distance = MATH_MIN(distance, abs(i - k));
+                }
+            }
+        }
+        return distance;
+    }
+
+    // The linear gradient from (x1, y1) to (x2, y2), as a transform from the image into the gradient
+    TransAffine LinearTransform(float x1, float y1, float x2, float y2)
+    {
+        TransAffine transform = TransAffine::TransAffineRotation(atan2f(y2 - y1, x2 - x1));
+        transform.Translate(x1, y1);
+        transform.Invert();
+        return transform;
+    }
+
+    /*
+     * Generate the spans of the rows of the image with both generators, and return the largest distance
+     * between the LUT entries of their pixels.
+     */
+    template <class Reference, class Span>
+    int32_t MaxIndexDistance(FillGradientLut& lut, Reference& reference, Span& span, int32_t left, uint32_t len)
+    {
+        static Rgba8T expect[MAX_SPAN];
+        static Rgba8T colors[MAX_SPAN];
+        int32_t maxDistance = 0;
+        for (int32_t y = 0; y < HEIGHT; y++) {
+            reference.Generate(expect, left, y, len);
+            span.Generate(colors, left, y, len);
+            for (uint32_t i = 0; i < len; i++) {
+                if (!SameColor(colors[i], expect[i])) {
+                    maxDistance = MATH_MAX(maxDistance, IndexDistance(lut, colors[i], expect[i]));
+                }
+            }
+        }
+        return maxDistance;
+    }
+
+    /*
+     * As MaxIndexDistance for the sweep gradients centered at (SWEEP_CENTER_X, SWEEP_CENTER_Y) in the image:
+     * the pixels near the center are skipped, and the first and last entries of the LUT are next to each other.
+     */
+    int32_t MaxSweepDistance(FillGradientLut& lut, FillGradient& reference,
+                             FillGradientSpan<GradientSweepCalculate>& span, int32_t left, uint32_t len)
+    {
+        static Rgba8T expect[MAX_SPAN];
+        static Rgba8T colors[MAX_SPAN];
+        int32_t size = static_cast<int32_t>(lut.GetSize());
+        int32_t maxDistance = 0;
+        for (int32_t y = 0; y < HEIGHT; y++) {
+            reference.Generate(expect, left, y, len);
+            span.Generate(colors, left, y, len);
+            for (uint32_t i = 0; i < len; i++) {
+                float dx = left + static_cast<int32_t>(i) - SWEEP_CENTER_X;
+                float dy = y - SWEEP_CENTER_Y;
+                if (SameColor(colors[i], expect[i]) || dx * dx + dy * dy < SWEEP_CENTER_RADIUS * SWEEP_CENTER_RADIUS) {
+                    continue;
+                }
+                int32_t distance = IndexDistance(lut, colors[i], expect[i]);
+                maxDistance = MATH_MAX(maxDistance, MATH_MIN(distance, size - distance));
+            }
+        }
+        return maxDistance;
+    }
+}
+
+class FillGradientTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FillGradientSpan_001
+ * @tc.desc: Verify the linear FillGradientSpan is within INDEX_TOLERANCE LUT entries of FillGradient, and the
+ *           entries of a subpixel of its coordinates, for gradients of every direction and length and spans
+ *           starting before, in and after the gradient.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FillGradientTest, FillGradientSpan_001, TestSize.Level0)
+{
+    // The start and end points of the gradients, forwards, backwards, vertical and short
+    const float gradients[][4] = {
+        {20.0f, 30.0f, 220.0f, 130.0f}, {300.5f, 200.25f, 10.0f, 40.0f}, {100.0f, 10.0f, 100.0f, 240.0f},
+        {150.0f, 100.0f, 170.0f, 90.0f}
+    };
+    const int32_t lefts[] = {-60, 0, 37};
+    const uint32_t lens[] = {1, 7, 300};
+    FillGradientLut lut;
+    BuildTestLut(lut);
+    for (const float* points : gradients) {
+        TransAffine transform = LinearTransform(points[0], points[1], points[2], points[3]); // 2, 3: the end
+        float distance = sqrtf((points[2] - points[0]) * (points[2] - points[0]) + // 2: x2
+                               (points[3] - points[1]) * (points[3] - points[1])); // 3: y2
+        FillInterpolator referenceInterpolator(transform);
+        FillInterpolator interpolator(transform);
+        GradientLinearCalculate function;
+        FillGradient reference(referenceInterpolator, function, lut, 0, distance);
+        FillGradientSpan<GradientLinearCalculate> span(interpolator, function, lut, 0, distance);
+        float subpixelEntries = lut.GetSize() / (distance * GRADIENT_SUBPIXEL_SCALE);
+        int32_t tolerance = INDEX_TOLERANCE + static_cast<int32_t>(subpixelEntries);
+        for (int32_t left : lefts) {
+            for (uint32_t len : lens) {
+                EXPECT_LE(MaxIndexDistance(lut, reference, span, left, len), tolerance)
+                    << points[0] << ", " << points[1] << " left " << left << " len " << len;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FillGradientSpan_002
+ * @tc.desc: Verify the radial FillGradientSpan is within RADIAL_INDEX_TOLERANCE LUT entries of FillGradient,
+ *           and the entries of a subpixel of its coordinates, for concentric and offset circles.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FillGradientTest, FillGradientSpan_002, TestSize.Level0)
+{
+    // The end radius, the start center relative to the end center and the start radius
+    const float gradients[][4] = {
+        {150.0f, 0.0f, 0.0f, 0.0f}, {150.0f, 20.0f, -10.0f, 5.0f}, {40.0f, 0.0f, 0.0f, 10.0f},
+        {90.0f, -50.0f, 30.0f, 0.0f}
+    };
+    const int32_t lefts[] = {-20, 100};
+    const uint32_t lens[] = {1, 3, 5, MAX_SPAN};
+    FillGradientLut lut;
+    BuildTestLut(lut);
+    TransAffine transform = TransAffine::TransAffineTranslation(128.0f, 120.0f); // 128, 120: the end center
+    transform.Invert();
+    for (const float* circles : gradients) {
+        FillInterpolator referenceInterpolator(transform);
+        FillInterpolator interpolator(transform);
+        float endRadius = circles[0];
+        float startRadius = circles[3]; // 3: the start radius
+        GradientRadialCalculate function(endRadius, circles[1], circles[2]); // 2: the start center y
+        FillGradient reference(referenceInterpolator, function, lut, startRadius, endRadius);
+        FillGradientSpan<GradientRadialCalculate> span(interpolator, function, lut, startRadius, endRadius);
+        float subpixelEntries = lut.GetSize() / ((endRadius - startRadius) * GRADIENT_SUBPIXEL_SCALE);
+        int32_t tolerance = RADIAL_INDEX_TOLERANCE + static_cast<int32_t>(subpixelEntries);
+        for (int32_t left : lefts) {
+            for (uint32_t len : lens) {
+                EXPECT_LE(MaxIndexDistance(lut, reference, span, left, len), tolerance)
+                    << circles[0] << ", " << circles[1] << " left " << left << " len " << len;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FillGradientSpan_003
+ * @tc.desc: Verify the sweep FillGradientSpan is within SWEEP_INDEX_TOLERANCE LUT entries of FillGradient,
+ *           and the entries of a subpixel at SWEEP_CENTER_RADIUS, for full and partial sweeps of rotated
+ *           and scaled gradients.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FillGradientTest, FillGradientSpan_003, TestSize.Level0)
+{
+    // The start and end angles in degrees, the rotation in radians and the scale
+    const float gradients[][4] = {
+        {0.0f, 360.0f, 0.0f, 1.0f}, {45.0f, 315.0f, 0.0f, 1.0f}, {-100.0f, 20.0f, 0.7f, 1.0f},
+        {400.0f, 490.0f, -2.0f, 0.5f}
+    };
+    const int32_t lefts[] = {-20, 100};
+    const uint32_t lens[] = {1, 3, 5, MAX_SPAN};
+    FillGradientLut lut;
+    BuildTestLut(lut);
+    for (const float* angles : gradients) {
+        TransAffine transform = TransAffine::TransAffineScaling(angles[3]); // 3: the scale
+        transform.Rotate(angles[2]); // 2: the rotation
+        transform.Translate(SWEEP_CENTER_X, SWEEP_CENTER_Y);
+        transform.Invert();
+        FillInterpolator referenceInterpolator(transform);
+        FillInterpolator interpolator(transform);
+        GradientSweepCalculate function(angles[0], angles[1]);
+        FillGradient reference(referenceInterpolator, function, lut, 0, 0);
+        FillGradientSpan<GradientSweepCalculate> span(interpolator, function, lut, 0, 0);
+        // A subpixel of the gradient at the center radius, scaled to the gradient, and as both ends are rounded
+        float subpixelAngle = 2.0f / (SWEEP_CENTER_RADIUS * angles[3] * GRADIENT_SUBPIXEL_SCALE); // 2: both ends
+        float subpixelEntries = subpixelAngle * function.GetIndexScale() * lut.GetSize();
+        int32_t tolerance = SWEEP_INDEX_TOLERANCE + static_cast<int32_t>(subpixelEntries);
+        for (int32_t left : lefts) {
+            for (uint32_t len : lens) {
+                EXPECT_LE(MaxSweepDistance(lut, reference, span, left, len), tolerance)
+                    << angles[0] << ", " << angles[1] << " left " << left << " len " << len;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: GradientSweepCalculate_001
+ * @tc.desc: Verify the sweep runs clockwise from the start angle, and the angles out of the sweep take
+ *           the last entry.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FillGradientTest, GradientSweepCalculate_001, TestSize.Level0)
+{
+    const int16_t size = 512;
+    const int16_t radius = 1000;
+    GradientSweepCalculate full;
+    EXPECT_EQ(full.Calculate(radius, 1, 0, 0, size), 0);
+    EXPECT_EQ(full.Calculate(0, radius, 0, 0, size), size / 4);      // 4: a quarter, down as y points down
+    EXPECT_EQ(full.Calculate(-radius, 1, 0, 0, size), size / 2 - 1); // 2: just before a half
+    EXPECT_EQ(full.Calculate(0, -radius, 0, 0, size), size * 3 / 4); // 3 / 4: three quarters
+    EXPECT_EQ(full.Calculate(radius, -1, 0, 0, size), size - 1);
+
+    // From 90 to 180 degrees, and the same given a circle later
+    GradientSweepCalculate quarter(90.0f, 180.0f); // 90, 180: the second quarter
+    GradientSweepCalculate later(450.0f, 540.0f); // 450, 540: the second quarter a circle later
+    const int16_t points[][2] = {{-1, radius}, {-radius, radius}, {-radius, 1}, {radius, 1}, {1, -radius}};
+    const int16_t expect[] = {0, size / 2, size - 1, size - 1, size - 1}; // 2: a half
+    for (uint32_t i = 0; i < sizeof(expect) / sizeof(expect[0]); i++) {
+        EXPECT_NEAR(quarter.Calculate(points[i][0], points[i][1], 0, 0, size), expect[i], 1) << i;
+        EXPECT_EQ(later.Calculate(points[i][0], points[i][1], 0, 0, size),
+                  quarter.Calculate(points[i][0], points[i][1], 0, 0, size)) << i;
+    }
+}
+
+/**
+ * @tc.name: GradientSweepCalculate_002
+ * @tc.desc: Verify start angles many circles away match the same angle within a circle,
+ *           and NaN or infinite angles give the full circle from 0 degrees.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FillGradientTest, GradientSweepCalculate_002, TestSize.Level0)
+{
+    GradientSweepCalculate full;
+    GradientSweepCalculate quarter(90.0f, 180.0f); // 90, 180: the second quarter
+    GradientSweepCalculate farAfter(36090.0f, 36180.0f); // 36090, 36180: 100 circles later
+    GradientSweepCalculate farBefore(-35910.0f, -35820.0f); // -35910, -35820: 100 circles earlier
+    EXPECT_NEAR(farAfter.GetStartAngle(), quarter.GetStartAngle(), 1e-5f);
+    EXPECT_NEAR(farBefore.GetStartAngle(), quarter.GetStartAngle(), 1e-5f);
+    EXPECT_FLOAT_EQ(farAfter.GetIndexScale(), quarter.GetIndexScale());
+    EXPECT_FLOAT_EQ(farBefore.GetIndexScale(), quarter.GetIndexScale());
+
+    GradientSweepCalculate huge(3e38f, 3e38f + 1.0f); // 3e38: a start angle of huge magnitude
+    EXPECT_GE(huge.GetStartAngle(), 0.0f);
+    EXPECT_LT(huge.GetStartAngle(), static_cast<float>(2 * UI_PI)); // 2: a circle
+    GradientSweepCalculate tiny(-1e-7f, 90.0f); // -1e-7: rounds to a circle once a circle is added
+    EXPECT_GE(tiny.GetStartAngle(), 0.0f);
+    EXPECT_LT(tiny.GetStartAngle(), static_cast<float>(2 * UI_PI)); // 2: a circle
+
+    const float invalid[] = {NAN, INFINITY, -INFINITY};
+    for (float angle : invalid) {
+        GradientSweepCalculate start(angle, 90.0f); // 90: a quarter
+        GradientSweepCalculate end(90.0f, angle); // 90: a quarter
+        for (GradientSweepCalculate* sweep : {&start, &end}) {
+            EXPECT_EQ(sweep->GetStartAngle(), full.GetStartAngle()) << angle;
+            EXPECT_EQ(sweep->GetIndexScale(), full.GetIndexScale()) << angle;
+        }
+    }
+}
+#endif
+} // namespace OHOS
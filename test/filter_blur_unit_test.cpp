@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_blur.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+namespace {
+    const int32_t MAX_WIDTH = 70;
+    const int32_t MAX_HEIGHT = 45;
+    // The bytes after every row, which the blur must not touch
+    const int32_t PADDING = 12;
+    const int32_t MAX_STRIDE = MAX_WIDTH * FOUR_TIMES + PADDING;
+    const uint8_t PADDING_BYTE = 0xA5;
+    // The B, G and R channels blurred by BLUR_MODE_COLOR
+    const int32_t COLOR_BYTES = 3;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    // The blocks of one color of the images blurred like a Gaussian, whose edges the blur smooths
+    const int32_t BLOCK_SIZE = 6;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // A BGRA or A8 image of rows of stride bytes, as the pixel formats give it to BoxBlur
+    class TestImage {
+    public:
+        TestImage(int32_t width, int32_t height, uint8_t* pixels, int32_t pixelBytes = FOUR_TIMES)
+            : width_(width), height_(height), pixelBytes_(pixelBytes), pixels_(pixels) {}
+
+        int32_t GetWidth() const
+        {
+            return width_;
+        }
+
+        int32_t GetHeight() const
+        {
+            return height_;
+        }
+
+        uint8_t* PixValuePtr(int32_t x, int32_t y)
+        {
+            return pixels_ + y * (width_ * pixelBytes_ + PADDING) + x * pixelBytes_;
+        }
+
+    private:
+        int32_t width_;
+        int32_t height_;
+        int32_t pixelBytes_;
+        uint8_t* pixels_;
+    };
+
+    void FillImage(uint8_t* pixels, int32_t width, int32_t height, uint32_t seed, int32_t pixelBytes = FOUR_TIMES)
+    {
+        int32_t stride = width * pixelBytes + PADDING;
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t i = 0; i < stride; i++) {
+                bool inside = i < width * pixelBytes;
+                pixels[y * stride + i] = inside ? static_cast<uint8_t>(NextRandom(seed)) : PADDING_BYTE;
+            }
+        }
+    }
+
+    // The average with halves rounded up, as BoxBlur rounds each pass
+    uint8_t RoundedAverage(uint32_t sum, uint32_t count)
+    {
+        return static_cast<uint8_t>((sum * 2 + count) / (count * 2)); // 2: round halves up
+    }
+
+    /*
+     * The box blur computed straight from its definition, a box of 2 * radius + 1 pixels clipped
+     * at the borders, along the rows and then along the columns of the first blurBytes bytes of every pixel,
+     * by default the B, G and R channels.
+     */
+    void ReferenceBoxBlur(uint8_t* pixels, int32_t width, int32_t height, int32_t radius,
+                          int32_t pixelBytes = FOUR_TIMES, int32_t blurBytes = COLOR_BYTES)
+    {
+        static uint8_t rows[MAX_STRIDE * MAX_HEIGHT];
+        int32_t stride = width * pixelBytes + PADDING;
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                for (int32_t c = 0; c < blurBytes; c++) {
+                    uint32_t sum = 0;
+                    uint32_t count = 0;
+                    for (int32_t k = MATH_MAX(x - radius, 0); k <= MATH_MIN(x + radius, width - 1); k++) {
+                        sum += pixels[y * stride + k * pixelBytes + c];
+                        count++;
+                    }
+                    rows[y * stride + x * pixelBytes + c] = RoundedAverage(sum, count);
+                }
+            }
+        }
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                for (int32_t c = 0; c < blurBytes; c++) {
+                    uint32_t sum = 0;
+                    uint32_t count = 0;
+                    for (int32_t k = MATH_MAX(y - radius, 0); k <= MATH_MIN(y + radius, height - 1); k++) {
+                        sum += rows[k * stride + x * pixelBytes + c];
+                        count++;
+                    }
+                    pixels[y * stride + x * pixelBytes + c] = RoundedAverage(sum, count);
+                }
+            }
+        }
+    }
+
+    // Blocks of random colors and alphas, with the same padding as FillImage
+    void FillBlocks(uint8_t* pixels, int32_t width, int32_t height, uint32_t seed)
+    {
+        FillImage(pixels, width, height, seed);
+        int32_t stride = width * FOUR_TIMES + PADDING;
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                uint32_t blockSeed = seed + (y / BLOCK_SIZE) * MAX_WIDTH + x / BLOCK_SIZE;
+                for (int32_t c = 0; c < COLOR_BYTES; c++) {
+                    pixels[y * stride + x * FOUR_TIMES + c] = static_cast<uint8_t>(NextRandom(blockSeed));
+                }
+            }
+        }
+    }
+
+    /*
+     * The mean difference of the blurred channels to a Gaussian of sigma in float,
+     * normalized by the weights inside the image at the borders.
+     */
+    float GaussianError(const uint8_t* blurred, const uint8_t* pixels, int32_t width, int32_t height, float sigma,
+                        int32_t pixelBytes = FOUR_TIMES, int32_t blurBytes = COLOR_BYTES)
+    {
+        static float rows[MAX_WIDTH * MAX_HEIGHT * FOUR_TIMES];
+        int32_t stride = width * pixelBytes + PADDING;
+        int32_t radius = static_cast<int32_t>(ceilf(sigma * 3.0f)); // 3: beyond three sigmas is negligible
+        for (int32_t pass = 0; pass < 2; pass++) { // 2: the rows then the columns
+            float error = 0;
+            for (int32_t y = 0; y < height; y++) {
+                for (int32_t x = 0; x < width; x++) {
+                    for (int32_t c = 0; c < blurBytes; c++) {
+                        float sum = 0;
+                        float weights = 0;
+                        for (int32_t k = -radius; k <= radius; k++) {
+                            int32_t px = (pass == 0) ? x + k : x;
+                            int32_t py = (pass == 0) ? y : y + k;
+                            if (px < 0 || px >= width || py < 0 || py >= height) {
+                                continue;
+                            }
+                            float weight = expf(-0.5f * k * k / (sigma * sigma)); // 0.5: exp(-k^2 / (2 sigma^2))
+                            float value = (pass == 0) ? pixels[py * stride + px * pixelBytes + c] :
+                                                        rows[(py * width + px) * blurBytes + c];
+                            sum += weight * value;
+                            weights += weight;
+                        }
+                        if (pass == 0) {
+                            rows[(y * width + x) * blurBytes + c] = sum / weights;
+                        } else {
+                            error += fabsf(sum / weights - blurred[y * stride + x * pixelBytes + c]);
+                        }
+                    }
+                }
+            }
+            if (pass == 1) {
+                return error / (width * height * blurBytes);
+            }
+        }
+        return 0;
+    }
+
+    // A premultiplied BGRA image, whose B, G and R are at most its alpha
+    void FillPremultiplied(uint8_t* pixels, int32_t width, int32_t height, uint32_t seed)
+    {
+        FillImage(pixels, width, height, seed);
+        int32_t stride = width * FOUR_TIMES + PADDING;
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                uint8_t* pixel = pixels + y * stride + x * FOUR_TIMES;
+                for (int32_t c = 0; c < COLOR_BYTES; c++) {
+                    pixel[c] = static_cast<uint8_t>(pixel[c] * pixel[COLOR_BYTES] / 255); // 255: full alpha
+                }
+            }
+        }
+    }
+
+    // The bytes other than the blurred channels, e.g. alpha, and the padding are equal
+    bool OthersKept(const uint8_t* image, const uint8_t* expect, int32_t width, int32_t height,
+                    int32_t pixelBytes = FOUR_TIMES, int32_t blurBytes = COLOR_BYTES)
+    {
+        int32_t stride = width * pixelBytes + PADDING;
+        for (int32_t i = 0; i < stride * height; i++) {
+            bool channel = (i % stride) < width * pixelBytes && (i % pixelBytes) < blurBytes;
+            if (!channel && image[i] != expect[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+class FilterBlurTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FilterBlurBoxBlur_001
+ * @tc.desc: Verify BoxBlur equals the separable box from its definition, for sizes around the strips
+ *           and radii up to beyond the image, keeping alpha and the bytes after every row.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlur_001, TestSize.Level0)
+{
+    const int32_t widths[] = {1, 15, 16, 17, 33, MAX_WIDTH};
+    const int32_t heights[] = {1, 2, 9, MAX_HEIGHT};
+    const uint16_t radii[] = {1, 2, 5, 16, 100};
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t expect[MAX_STRIDE * MAX_HEIGHT];
+    Filterblur blur;
+    uint32_t seed = 1;
+    for (int32_t width : widths) {
+        for (int32_t height : heights) {
+            for (uint16_t radius : radii) {
+                FillImage(image, width, height, seed++);
+                int32_t size = (width * FOUR_TIMES + PADDING) * height;
+                ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, size), EOK);
+                ReferenceBoxBlur(expect, width, height, radius);
+                TestImage img(width, height, image);
+                blur.BoxBlur(img, radius, FOUR_TIMES, width * FOUR_TIMES + PADDING);
+                ASSERT_EQ(memcmp(image, expect, size), 0) << width << "x" << height << " radius " << radius;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlur_002
+ * @tc.desc: Verify a zero radius or a channel count other than four leaves the image as it is,
+ *           and a copied Filterblur blurs with buffers of its own.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlur_002, TestSize.Level0)
+{
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t expect[MAX_STRIDE * MAX_HEIGHT];
+    const int32_t stride = MAX_STRIDE;
+    FillImage(image, MAX_WIDTH, MAX_HEIGHT, 3); // 3: seed
+    ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, sizeof(image)), EOK);
+    TestImage img(MAX_WIDTH, MAX_HEIGHT, image);
+    Filterblur blur;
+    blur.BoxBlur(img, 0, FOUR_TIMES, stride);
+    blur.BoxBlur(img, 3, 3, stride); // 3: radius, 3: channels
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 4); // 4: radius
+    blur.BoxBlur(img, 4, FOUR_TIMES, stride); // 4: radius
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    Filterblur copy = blur;
+    ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 7); // 7: radius
+    copy.BoxBlur(img, 7, FOUR_TIMES, stride); // 7: radius
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlur_004
+ * @tc.desc: Verify a copy of a Filterblur that has not blurred yet, and one assigned from it, blur as a new one.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlur_004, TestSize.Level0)
+{
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t expect[MAX_STRIDE * MAX_HEIGHT];
+    const int32_t stride = MAX_STRIDE;
+    FillImage(image, MAX_WIDTH, MAX_HEIGHT, 5); // 5: seed
+    ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, sizeof(image)), EOK);
+    TestImage img(MAX_WIDTH, MAX_HEIGHT, image);
+    Filterblur fresh;
+    Filterblur copy(fresh);
+    ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 3); // 3: radius
+    copy.BoxBlur(img, 3, FOUR_TIMES, stride); // 3: radius
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    Filterblur assigned;
+    assigned.BoxBlur(img, 2, FOUR_TIMES, stride); // 2: radius
+    ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 2); // 2: radius
+    assigned = fresh;
+    ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 5); // 5: radius
+    assigned.BoxBlur(img, 5, FOUR_TIMES, stride); // 5: radius
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+}
+
+/**
+ * @tc.name: FilterBlurGaussianBlur_001
+ * @tc.desc: Verify GaussianBlur is three box blurs, of radius 2 for a sigma of 2.5.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurGaussianBlur_001, TestSize.Level0)
+{
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t expect[MAX_STRIDE * MAX_HEIGHT];
+    FillImage(image, MAX_WIDTH, MAX_HEIGHT, 5); // 5: seed
+    ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, sizeof(image)), EOK);
+    for (int32_t i = 0; i < Filterblur::GAUSSIAN_BOX_PASSES; i++) {
+        ReferenceBoxBlur(expect, MAX_WIDTH, MAX_HEIGHT, 2); // 2: radius
+    }
+    TestImage img(MAX_WIDTH, MAX_HEIGHT, image);
+    Filterblur blur;
+    blur.GaussianBlur(img, 2.5f, FOUR_TIMES, MAX_STRIDE, false); // 2.5: sigma
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    // Even downsampled, a sigma up to BLUR_DOWNSAMPLE_SIGMA is blurred at full resolution
+    FillImage(image, MAX_WIDTH, MAX_HEIGHT, 5); // 5: seed
+    blur.GaussianBlur(img, 2.5f, FOUR_TIMES, MAX_STRIDE); // 2.5: sigma
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+}
+
+/**
+ * @tc.name: FilterBlurGaussianBlur_002
+ * @tc.desc: Verify GaussianBlur at full resolution and downsampled is close to a float Gaussian,
+ *           keeping alpha and the bytes after every row.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurGaussianBlur_002, TestSize.Level0)
+{
+    const float sigmas[] = {1.5f, 3.0f, 6.0f, 12.0f};
+    // The mean error allowed, in levels of a channel
+    const float fullError = 1.5f;
+    const float downsampleError = 2.0f;
+    static uint8_t pixels[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    FillBlocks(pixels, MAX_WIDTH, MAX_HEIGHT, 7); // 7: seed
+    TestImage img(MAX_WIDTH, MAX_HEIGHT, image);
+    Filterblur blur;
+    for (float sigma : sigmas) {
+        for (bool downsample : {false, true}) {
+            ASSERT_EQ(memcpy_s(image, sizeof(image), pixels, sizeof(pixels)), EOK);
+            blur.GaussianBlur(img, sigma, FOUR_TIMES, MAX_STRIDE, downsample);
+            float error = GaussianError(image, pixels, MAX_WIDTH, MAX_HEIGHT, sigma);
+            bool scaled = downsample && sigma > Filterblur::BLUR_DOWNSAMPLE_SIGMA;
+            EXPECT_LE(error, scaled ? downsampleError : fullError) << "sigma " << sigma << " " << downsample;
+            EXPECT_TRUE(OthersKept(image, pixels, MAX_WIDTH, MAX_HEIGHT)) << "sigma " << sigma;
+        }
+    }
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlur_003
+ * @tc.desc: Verify BoxBlur of the four channels of a premultiplied image and of an A8 mask equals the separable
+ *           box from its definition, for sizes around the strips of 64 bytes, keeping the bytes after every row.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlur_003, TestSize.Level0)
+{
+    const int32_t widths[] = {1, 15, 16, 17, 63, 64, 65, MAX_WIDTH};
+    const int32_t heights[] = {1, 9, MAX_HEIGHT};
+    const uint16_t radii[] = {1, 3, 40};
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t expect[MAX_STRIDE * MAX_HEIGHT];
+    Filterblur blur;
+    uint32_t seed = 11; // 11: seed
+    for (int32_t width : widths) {
+        for (int32_t height : heights) {
+            for (uint16_t radius : radii) {
+                FillImage(image, width, height, seed++);
+                int32_t size = (width * FOUR_TIMES + PADDING) * height;
+                ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, size), EOK);
+                ReferenceBoxBlur(expect, width, height, radius, FOUR_TIMES, FOUR_TIMES);
+                TestImage img(width, height, image);
+                int32_t stride = width * FOUR_TIMES + PADDING;
+                blur.BoxBlur(img, radius, FOUR_TIMES, stride, Filterblur::BLUR_MODE_PREMULTIPLIED);
+                ASSERT_EQ(memcmp(image, expect, size), 0) << width << "x" << height << " radius " << radius;
+
+                FillImage(image, width, height, seed++, 1);
+                size = (width + PADDING) * height;
+                ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, size), EOK);
+                ReferenceBoxBlur(expect, width, height, radius, 1, 1);
+                TestImage mask(width, height, image, 1);
+                blur.BoxBlur(mask, radius, 1, width + PADDING, Filterblur::BLUR_MODE_ALPHA8);
+                ASSERT_EQ(memcmp(image, expect, size), 0) << "A8 " << width << "x" << height << " radius " << radius;
+            }
+        }
+    }
+    // A channel count other than the one of the mode
+    TestImage img(MAX_WIDTH, MAX_HEIGHT, image, 1);
+    FillImage(image, MAX_WIDTH, MAX_HEIGHT, seed, 1);
+    ASSERT_EQ(memcpy_s(expect, sizeof(expect), image, sizeof(image)), EOK);
+    blur.BoxBlur(img, 2, FOUR_TIMES, MAX_WIDTH + PADDING, Filterblur::BLUR_MODE_ALPHA8); // 2: radius
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+}
+
+/**
+ * @tc.name: FilterBlurGaussianBlur_003
+ * @tc.desc: Verify GaussianBlur of an A8 mask is close to a float Gaussian, and the premultiplied blur
+ *           keeps every channel at most its alpha.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(FilterBlurTest, FilterBlurGaussianBlur_003, TestSize.Level0)
+{
+    const float sigmas[] = {1.5f, 6.0f, 12.0f};
+    // The mean error allowed, in levels, as for the color blur
+    const float maxError = 2.0f;
+    static uint8_t pixels[MAX_STRIDE * MAX_HEIGHT];
+    static uint8_t image[MAX_STRIDE * MAX_HEIGHT];
+    Filterblur blur;
+    for (float sigma : sigmas) {
+        for (bool downsample : {false, true}) {
+            FillImage(pixels, MAX_WIDTH, MAX_HEIGHT, 13, 1); // 13: seed
+            ASSERT_EQ(memcpy_s(image, sizeof(image), pixels, sizeof(pixels)), EOK);
+            TestImage mask(MAX_WIDTH, MAX_HEIGHT, image, 1);
+            blur.GaussianBlur(mask, sigma, 1, MAX_WIDTH + PADDING, downsample, Filterblur::BLUR_MODE_ALPHA8);
+            float error = GaussianError(image, pixels, MAX_WIDTH, MAX_HEIGHT, sigma, 1, 1);
+            EXPECT_LE(error, maxError) << "sigma " << sigma;
+            EXPECT_TRUE(OthersKept(image, pixels, MAX_WIDTH, MAX_HEIGHT, 1, 1)) << "sigma " << sigma;
+
+            FillPremultiplied(image, MAX_WIDTH, MAX_HEIGHT, 17); // 17: seed
+            TestImage img(MAX_WIDTH, MAX_HEIGHT, image);
+            blur.GaussianBlur(img, sigma, FOUR_TIMES, MAX_STRIDE, downsample, Filterblur::BLUR_MODE_PREMULTIPLIED);
+            for (int32_t y = 0; y < MAX_HEIGHT; y++) {
+                for (int32_t x = 0; x < MAX_WIDTH; x++) {
+                    const uint8_t* pixel = image + y * MAX_STRIDE + x * FOUR_TIMES;
+                    for (int32_t c = 0; c < COLOR_BYTES; c++) {
+                        ASSERT_LE(pixel[c], pixel[COLOR_BYTES]) << "sigma " << sigma << " at " << x << ", " << y;
+                    }
+                }
+            }
+        }
+    }
+}
+#endif
+} // namespace OHOS
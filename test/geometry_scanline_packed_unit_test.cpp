@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t MIN_X = -20;
+    const int32_t MAX_X = 100;
+
+    void ExpectSpan(GeometryScanlinePacked::ConstIterator span, int32_t x, int32_t spanLength, uint8_t firstCover)
+    {
+        EXPECT_EQ(span->x, x);
+        EXPECT_EQ(span->spanLength, spanLength);
+        EXPECT_EQ(span->covers[0], firstCover);
+    }
+}
+
+class GeometryScanlinePackedTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: GeometryScanlinePacked_001
+ * @tc.desc: Verify adjacent cells join one span with a cover per pixel, and cells apart start new spans.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GeometryScanlinePackedTest, GeometryScanlinePacked_001, TestSize.Level0)
+{
+    const uint8_t covers[] = {10, 20, 30, 40};
+    GeometryScanlinePacked sl;
+    sl.Reset(MIN_X, MAX_X);
+    EXPECT_EQ(sl.NumSpans(), 0u);
+    sl.AddCell(-20, 1);  // -20: the first pixel
+    sl.AddCell(-19, 2);  // -19: adjacent
+    sl.AddCells(-18, 4, covers); // -18: adjacent, 4: cells
+    sl.AddCell(0, 3);    // 0: apart
+    sl.AddCells(5, 2, covers); // 5: apart, 2: cells
+    sl.Finalize(7);      // 7: the row
+    EXPECT_EQ(sl.GetYLevel(), 7);
+    ASSERT_EQ(sl.NumSpans(), 3u); // 3: spans
+    GeometryScanlinePacked::ConstIterator span = sl.Begin();
+    ExpectSpan(span, -20, 6, 1); // -20: x, 6: length
+    EXPECT_EQ(span->covers[1], 2);
+    EXPECT_EQ(span->covers[5], 40); // 5: the last cover, 40: covers[3]
+    ExpectSpan(++span, 0, 1, 3);
+    ExpectSpan(++span, 5, 2, 10); // 5: x, 2: length, 10: covers[0]
+    EXPECT_EQ(span->covers[1], 20); // 20: covers[1]
+}
+
+/**
+ * @tc.name: GeometryScanlinePacked_002
+ * @tc.desc: Verify solid spans keep one cover, merge with an adjacent solid span of the same cover only.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(GeometryScanlinePackedTest, GeometryScanlinePacked_002, TestSize.Level0)
+{
+    GeometryScanlinePacked sl;
+    sl.Reset(MIN_X, MAX_X);
+    sl.AddCell(0, 100);       // 0: x, 100: cover
+    sl.AddSpan(1, 10, 255);   // 1: adjacent to the cell, 10: length, 255: cover
+    sl.AddSpan(11, 5, 255);   // 11: adjacent, 5: length, 255: the same cover
+    sl.AddSpan(16, 3, 128);   // 16: adjacent, 3: length, 128: another cover
+    sl.AddSpan(20, 2, 128);   // 20: apart, 2: length, 128: the same cover
+    sl.AddCell(22, 50);       // 22: adjacent to the solid span, 50: cover
+    sl.AddCell(23, 60);       // 23: adjacent to the cell, 60: cover
+    ASSERT_EQ(sl.NumSpans(), 5u); // 5: spans
+    GeometryScanlinePacked::ConstIterator span = sl.Begin();
+    ExpectSpan(span, 0, 1, 100);      // 0: x, 1: length, 100: cover
+    ExpectSpan(++span, 1, -15, 255);  // 1: x, -15: solid of 15 pixels, 255: cover
+    ExpectSpan(++span, 16, -3, 128);  // 16: x, -3: solid of 3 pixels, 128: cover
+    ExpectSpan(++span, 20, -2, 128);  // 20: x, -2: solid of 2 pixels, 128: cover
+    ExpectSpan(++span, 22, 2, 50);    // 22: x, 2: length, 50: cover
+    EXPECT_EQ(span->covers[1], 60);   // 60: the second cover
+
+    sl.ResetSpans();
+    EXPECT_EQ(sl.NumSpans(), 0u);
+    sl.AddSpan(MAX_X - 1, 2, 255); // 2: length up to MAX_X, 255: cover
+    ASSERT_EQ(sl.NumSpans(), 1u);
+    ExpectSpan(sl.Begin(), MAX_X - 1, -2, 255); // -2: solid of 2 pixels, 255: cover
+}
+} // namespace OHOS
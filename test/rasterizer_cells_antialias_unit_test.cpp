@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_cells_antialias.h"
+
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const uint32_t MAX_CELLS = 2048;
+    // RasterizerCellsAntiAlias::RADIX_SORT_THRESHOLD
+    const uint32_t RADIX_THRESHOLD = 64;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // Cells of one row, with x from minX up to minX + range - 1 and the index of the cell as its cover
+    void FillCells(CellBuildAntiAlias* cells, uint32_t num, int32_t minX, uint32_t range, uint32_t seed)
+    {
+        for (uint32_t i = 0; i < num; i++) {
+            cells[i].x = minX + static_cast<int32_t>(NextRandom(seed) % range);
+            cells[i].y = 0;
+            cells[i].cover = static_cast<int32_t>(i);
+            cells[i].area = 0;
+        }
+    }
+
+    // The pointers are sorted by x and each cell is still listed once
+    void ExpectSorted(CellBuildAntiAlias** sorted, uint32_t num, const CellBuildAntiAlias* cells)
+    {
+        bool listed[MAX_CELLS] = {false};
+        for (uint32_t i = 0; i < num; i++) {
+            uint32_t index = static_cast<uint32_t>(sorted[i] - cells);
+            ASSERT_LT(index, num);
+            EXPECT_FALSE(listed[index]);
+            listed[index] = true;
+            if (i > 0) {
+                ASSERT_LE(sorted[i - 1]->x, sorted[i]->x) << "at " << i << " of " << num;
+            }
+        }
+    }
+}
+
+class RasterizerCellsAntiAliasTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerCellsRadixSort_001
+ * @tc.desc: Verify RadixSortCells sorts rows around RADIX_SORT_THRESHOLD cells, narrow and wide, by x.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerCellsAntiAliasTest, RasterizerCellsRadixSort_001, TestSize.Level0)
+{
+    const uint32_t sizes[] = {1, 2, RADIX_THRESHOLD - 1, RADIX_THRESHOLD, RADIX_THRESHOLD + 1, 500, MAX_CELLS};
+    // One pass of 8 bits, two passes and four passes
+    const uint32_t ranges[] = {200, 60000, 0x7FFFFFF0};
+    const int32_t minXs[] = {0, -1000, INT32_MIN / 2};
+    static CellBuildAntiAlias cells[MAX_CELLS];
+    static CellBuildAntiAlias* sorted[MAX_CELLS];
+    static CellBuildAntiAlias* temp[MAX_CELLS];
+    uint32_t seed = 1;
+    for (uint32_t num : sizes) {
+        for (uint32_t range : ranges) {
+            for (int32_t minX : minXs) {
+                FillCells(cells, num, minX, range, seed++);
+                for (uint32_t i = 0; i < num; i++) {
+                    sorted[i] = cells + i;
+                }
+                RadixSortCells(sorted, num, temp);
+                ExpectSorted(sorted, num, cells);
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerCellsRadixSort_002
+ * @tc.desc: Verify RadixSortCells orders the x of the cells as QsortCells, and keeps equal x in their order.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerCellsAntiAliasTest, RasterizerCellsRadixSort_002, TestSize.Level0)
+{
+    static CellBuildAntiAlias cells[MAX_CELLS];
+    static CellBuildAntiAlias* radix[MAX_CELLS];
+    static CellBuildAntiAlias* quick[MAX_CELLS];
+    static CellBuildAntiAlias* temp[MAX_CELLS];
+    // Many equal x among the cells
+    FillCells(cells, MAX_CELLS, -100, 300, 7); // 7: seed, -100 and 300: x from -100 to 199
+    for (uint32_t i = 0; i < MAX_CELLS; i++) {
+        radix[i] = cells + i;
+        quick[i] = cells + i;
+    }
+    RadixSortCells(radix, MAX_CELLS, temp);
+    QsortCells(quick, MAX_CELLS);
+    for (uint32_t i = 0; i < MAX_CELLS; i++) {
+        ASSERT_EQ(radix[i]->x, quick[i]->x);
+        if (i > 0 && radix[i - 1]->x == radix[i]->x) {
+            ASSERT_LT(radix[i - 1]->cover, radix[i]->cover);
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerCellsRadixSort_003
+ * @tc.desc: Verify SortAllCells sorts crowded and sparse rows built by lines.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerCellsAntiAliasTest, RasterizerCellsRadixSort_003, TestSize.Level0)
+{
+    RasterizerCellsAntiAlias outline;
+    uint32_t seed = 3; // 3: seed
+    const int32_t width = 400 << POLY_SUBPIXEL_SHIFT; // 400: pixels
+    const int32_t height = 20 << POLY_SUBPIXEL_SHIFT; // 20: pixels, so that rows hold hundreds of cells
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    for (uint32_t i = 0; i < 200; i++) { // 200: lines
+        int32_t x = static_cast<int32_t>(NextRandom(seed) % width);
+        int32_t y = static_cast<int32_t>(NextRandom(seed) % height);
+        if (i > 0) {
+            outline.LineOperate(lastX, lastY, x, y);
+        }
+        lastX = x;
+        lastY = y;
+    }
+    outline.SortAllCells();
+    ASSERT_GT(outline.GetTotalCells(), 0u);
+
+    uint32_t total = 0;
+    uint32_t maxRowCells = 0;
+    for (int32_t y = outline.GetMinY(); y <= outline.GetMaxY(); y++) {
+        uint32_t num = outline.GetScanlineNumCells(y);
+        const CellBuildAntiAlias* const* cells = outline.GetScanlineCells(y);
+        for (uint32_t i = 0; i < num; i++) {
+            ASSERT_EQ(cells[i]->y, y);
+            if (i > 0) {
+                ASSERT_LE(cells[i - 1]->x, cells[i]->x);
+            }
+        }
+        total += num;
+        maxRowCells = (num > maxRowCells) ? num : maxRowCells;
+    }
+    EXPECT_EQ(total, outline.GetTotalCells());
+    EXPECT_GE(maxRowCells, RADIX_THRESHOLD);
+}
+
+/**
+ * @tc.name: RasterizerCellsInsertSort_001
+ * @tc.desc: Verify the cells sorted by value with InsertSortCells and RadixSortCells keep the order by pointer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerCellsAntiAliasTest, RasterizerCellsInsertSort_001, TestSize.Level0)
+{
+    const uint32_t sizes[] = {1, 2, RADIX_THRESHOLD - 1, RADIX_THRESHOLD, 500, MAX_CELLS};
+    static CellBuildAntiAlias cells[MAX_CELLS];
+    static CellBuildAntiAlias* pointers[MAX_CELLS];
+    static CellBuildAntiAlias* pointerTemp[MAX_CELLS];
+    static CellBuildAntiAlias inserted[MAX_CELLS];
+    static CellBuildAntiAlias radix[MAX_CELLS];
+    static CellBuildAntiAlias temp[MAX_CELLS];
+    uint32_t seed = 5; // 5: seed
+    for (uint32_t num : sizes) {
+        FillCells(cells, num, -50, 100, seed++); // -50 and 100: x from -50 to 49, many equal x
+        for (uint32_t i = 0; i < num; i++) {
+            pointers[i] = cells + i;
+            inserted[i] = cells[i];
+            radix[i] = cells[i];
+        }
+        RadixSortCells(pointers, num, pointerTemp);
+        InsertSortCells(inserted, num);
+        RadixSortCells(radix, num, temp);
+        for (uint32_t i = 0; i < num; i++) {
+            // Both are stable, so even the cells of equal x are in the same order
+            ASSERT_EQ(inserted[i].x, pointers[i]->x);
+            ASSERT_EQ(inserted[i].cover, pointers[i]->cover);
+            ASSERT_EQ(radix[i].x, pointers[i]->x);
+            ASSERT_EQ(radix[i].cover, pointers[i]->cover);
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerCellsLine_001
+ * @tc.desc: Verify the cells of oblique lines stay within the pixels of the line ends, and cover its height.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerCellsAntiAliasTest, RasterizerCellsLine_001, TestSize.Level0)
+{
+    RasterizerCellsAntiAlias outline;
+    uint32_t seed = 9; // 9: seed
+    const int32_t size = 256; // 256: pixels
+    for (uint32_t line = 0; line < 2000; line++) { // 2000: lines
+        // The ends at the edges of pixels, where a drift of one subpixel crosses to the next pixel
+        int32_t x1 = static_cast<int32_t>(NextRandom(seed) % size) << POLY_SUBPIXEL_SHIFT;
+        int32_t y1 = static_cast<int32_t>(NextRandom(seed) % (size << POLY_SUBPIXEL_SHIFT));
+        int32_t x2 = static_cast<int32_t>(NextRandom(seed) % size) << POLY_SUBPIXEL_SHIFT;
+        x2 += (line & 1) * POLY_SUBPIXEL_MASK;
+        int32_t y2 = static_cast<int32_t>(NextRandom(seed) % (size << POLY_SUBPIXEL_SHIFT));
+        outline.Reset();
+        outline.LineOperate(x1, y1, x2, y2);
+        outline.SortAllCells();
+        if (outline.GetTotalCells() == 0) {
+            continue;
+        }
+        int32_t minX = ((x1 < x2) ? x1 : x2) >> POLY_SUBPIXEL_SHIFT;
+        int32_t maxX = ((x1 < x2) ? x2 : x1) >> POLY_SUBPIXEL_SHIFT;
+        int32_t cover = 0;
+        for (int32_t y = outline.GetMinY(); y <= outline.GetMaxY(); y++) {
+            uint32_t num = outline.GetScanlineNumCells(y);
+            const CellBuildAntiAlias* const* cells = outline.GetScanlineCells(y);
+            for (uint32_t i = 0; i < num; i++) {
+                ASSERT_GE(cells[i]->x, minX) << x1 << ", " << y1 << " to " << x2 << ", " << y2;
+                ASSERT_LE(cells[i]->x, maxX) << x1 << ", " << y1 << " to " << x2 << ", " << y2;
+                cover += cells[i]->cover;
+            }
+        }
+        EXPECT_EQ(cover, y2 - y1);
+    }
+}
+} // namespace OHOS
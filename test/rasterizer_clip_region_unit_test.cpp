@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_clip_region.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "securec.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    // The pixels tested around the rectangles
+    const int32_t MARGIN = 2;
+    const int32_t WIDTH = 256;
+    const int32_t HEIGHT = 256;
+    const float PI = 3.14159265f;
+    // The covers clipped by the clip box differ as much from the unclipped covers
+    const int32_t CLIP_BOX_TOLERANCE = 3;
+
+    bool InRects(const Rect32* rects, uint32_t numRects, int32_t x, int32_t y)
+    {
+        for (uint32_t i = 0; i < numRects; i++) {
+            if (x >= rects[i].GetLeft() && x <= rects[i].GetRight() &&
+                y >= rects[i].GetTop() && y <= rects[i].GetBottom()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * Compare Contains to the rectangles on every pixel around them, visiting the rows from top to bottom
+     * as the sweep does, then from bottom to top so that the band searched is reset at every row.
+     */
+    void ExpectRects(RasterizerClipRegion& region, const Rect32* rects, uint32_t numRects)
+    {
+        int32_t minX = 0;
+        int32_t minY = 0;
+        int32_t maxX = 0;
+        int32_t maxY = 0;
+        for (uint32_t i = 0; i < numRects; i++) {
+            minX = MATH_MIN(minX, rects[i].GetLeft());
+            minY = MATH_MIN(minY, rects[i].GetTop());
+            maxX = MATH_MAX(maxX, rects[i].GetRight());
+            maxY = MATH_MAX(maxY, rects[i].GetBottom());
+        }
+        for (int32_t y = minY - MARGIN; y <= maxY + MARGIN; y++) {
+            for (int32_t x = minX - MARGIN; x <= maxX + MARGIN; x++) {
+                ASSERT_EQ(region.Contains(x, y), InRects(rects, numRects, x, y)) << x << ", " << y;
+            }
+        }
+        for (int32_t y = maxY + MARGIN; y >= minY - MARGIN; y--) {
+            for (int32_t x = maxX + MARGIN; x >= minX - MARGIN; x--) {
+                ASSERT_EQ(region.Contains(x, y), InRects(rects, numRects, x, y)) << x << ", " << y;
+            }
+        }
+    }
+
+    // A star crossing the rectangles of the tests
+    void AddStar(RasterizerScanlineAntialias& ras)
+    {
+        const uint32_t points = 11;
+        const float center = 128.3f;
+        const float radius = 120.0f;
+        for (uint32_t i = 0; i < points * 2; i++) { // 2: the outer and inner vertices
+            float angle = PI * i / points;
+            float r = (i & 1) ? radius * 0.4f : radius; // 0.4: the inner radius
+            if (i == 0) {
+                ras.MoveToByfloat(center + r * cosf(angle), center + r * sinf(angle));
+            } else {
+                ras.LineToByfloat(center + r * cosf(angle), center + r * sinf(angle));
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    /*
+     * Sweep the scanlines of the rasterizer into an image of WIDTH x HEIGHT alphas, through the region
+     * when it is given.
+     * @return The number of scanlines, or -1 for a scanline out of the image or out of order.
+     */
+    template <class Scanline>
+    int32_t SweepToImage(RasterizerScanlineAntialias& ras, RasterizerClipRegion* region, uint8_t* image)
+    {
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        if (!((region != nullptr) ? region->RewindScanlines(ras) : ras.RewindScanlines())) {
+            return 0;
+        }
+        Scanline sl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        int32_t lastY = INT32_MIN;
+        while ((region != nullptr) ? region->SweepScanline(ras, sl) : ras.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            if (y <= lastY || y < 0 || y >= HEIGHT) {
+                return -1;
+            }
+            lastY = y;
+            numScanlines++;
+            typename Scanline::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                int32_t length = span->spanLength;
+                bool solid = length < 0;
+                length = solid ? -length : length;
+                if (span->x < 0 || span->x + length > WIDTH) {
+                    return -1;
+                }
+                for (int32_t k = 0; k < length; k++) {
+                    image[y * WIDTH + span->x + k] = solid ? *span->covers : span->covers[k];
+                }
+            }
+        }
+        return numScanlines;
+    }
+}
+
+class RasterizerClipRegionTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerClipRegionContains_001
+ * @tc.desc: Verify Contains on one rectangle, whose right and bottom are inclusive.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegionContains_001, TestSize.Level0)
+{
+    Rect32 rects[] = {Rect32(3, 4, 12, 9)};
+    RasterizerClipRegion region;
+    region.SetRects(rects, 1);
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    EXPECT_TRUE(region.Contains(3, 4));
+    EXPECT_TRUE(region.Contains(12, 9));
+    EXPECT_FALSE(region.Contains(13, 9));
+    EXPECT_FALSE(region.Contains(12, 10));
+    ExpectRects(region, rects, 1);
+
+    region.Reset();
+    EXPECT_TRUE(region.IsEmpty());
+    EXPECT_FALSE(region.Contains(3, 4));
+}
+
+/**
+ * @tc.name: RasterizerClipRegionContains_002
+ * @tc.desc: Verify empty rectangles are skipped, alone or among others.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegionContains_002, TestSize.Level0)
+{
+    RasterizerClipRegion region;
+    region.SetRects(nullptr, 0);
+    EXPECT_TRUE(region.IsEmpty());
+
+    // Right before left, bottom before top
+    Rect32 empty[] = {Rect32(10, 0, 9, 10), Rect32(0, 10, 10, 9)};
+    region.SetRects(empty, sizeof(empty) / sizeof(empty[0]));
+    EXPECT_TRUE(region.IsEmpty());
+    EXPECT_FALSE(region.Contains(9, 5));
+    EXPECT_FALSE(region.Contains(5, 9));
+
+    Rect32 rects[] = {Rect32(10, 0, 9, 10), Rect32(2, 2, 6, 6), Rect32(0, 10, 10, 9)};
+    region.SetRects(rects, sizeof(rects) / sizeof(rects[0]));
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    EXPECT_FALSE(region.Contains(9, 5));
+    EXPECT_FALSE(region.Contains(5, 9));
+    ExpectRects(region, rects + 1, 1);
+}
+
+/**
+ * @tc.name: RasterizerClipRegionContains_003
+ * @tc.desc: Verify overlapping, nested and touching rectangles of the same band merge, and apart ones do not.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegionContains_003, TestSize.Level0)
+{
+    RasterizerClipRegion region;
+    Rect32 overlapping[] = {Rect32(5, 0, 20, 9), Rect32(0, 0, 10, 9), Rect32(8, 0, 9, 9)};
+    region.SetRects(overlapping, sizeof(overlapping) / sizeof(overlapping[0]));
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    ExpectRects(region, overlapping, sizeof(overlapping) / sizeof(overlapping[0]));
+
+    Rect32 touching[] = {Rect32(10, 0, 19, 9), Rect32(0, 0, 9, 9)};
+    region.SetRects(touching, sizeof(touching) / sizeof(touching[0]));
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    ExpectRects(region, touching, sizeof(touching) / sizeof(touching[0]));
+
+    Rect32 apart[] = {Rect32(20, 0, 24, 9), Rect32(0, 0, 4, 9), Rect32(10, 0, 14, 9), Rect32(12, 0, 16, 9)};
+    region.SetRects(apart, sizeof(apart) / sizeof(apart[0]));
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    EXPECT_FALSE(region.Contains(5, 5));
+    EXPECT_FALSE(region.Contains(17, 5));
+    ExpectRects(region, apart, sizeof(apart) / sizeof(apart[0]));
+}
+
+/**
+ * @tc.name: RasterizerClipRegionContains_004
+ * @tc.desc: Verify rectangles overlapping in y split into bands, and stacked equal rows join one band.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegionContains_004, TestSize.Level0)
+{
+    RasterizerClipRegion region;
+    Rect32 stacked[] = {Rect32(0, 5, 9, 9), Rect32(0, 0, 9, 4)};
+    region.SetRects(stacked, sizeof(stacked) / sizeof(stacked[0]));
+    EXPECT_EQ(region.GetNumBands(), 1u);
+    ExpectRects(region, stacked, sizeof(stacked) / sizeof(stacked[0]));
+
+    // Rows 0-4 hold the first, 5-9 both, 10-14 the second and 15-17 none
+    Rect32 crossing[] = {Rect32(0, 0, 9, 9), Rect32(5, 5, 14, 14), Rect32(-3, 18, 2, 20)};
+    region.SetRects(crossing, sizeof(crossing) / sizeof(crossing[0]));
+    EXPECT_EQ(region.GetNumBands(), 4u);
+    EXPECT_FALSE(region.Contains(0, 16));
+    ExpectRects(region, crossing, sizeof(crossing) / sizeof(crossing[0]));
+
+    Rect32 grid[] = {Rect32(0, 0, 3, 3), Rect32(6, 0, 9, 3), Rect32(0, 6, 3, 9), Rect32(6, 6, 9, 9),
+                     Rect32(2, 2, 7, 7), Rect32(4, 4, 5, 5), Rect32(8, 8, 7, 7)};
+    region.SetRects(grid, sizeof(grid) / sizeof(grid[0]));
+    ExpectRects(region, grid, sizeof(grid) / sizeof(grid[0]));
+}
+
+/**
+ * @tc.name: RasterizerClipRegionSweep_001
+ * @tc.desc: Verify the scanlines swept through the region are the unclipped scanlines cut to the rectangles.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegionSweep_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    Rect32 rects[] = {Rect32(10, 10, 100, 80), Rect32(60, 50, 200, 120), Rect32(30, 150, 60, 250),
+                      Rect32(120, 160, 250, 170), Rect32(180, 140, 190, 240)};
+    const uint32_t numRects = sizeof(rects) / sizeof(rects[0]);
+    RasterizerClipRegion region;
+    region.SetRects(rects, numRects);
+    RasterizerScanlineAntialias ras;
+    AddStar(ras);
+    ASSERT_GT(SweepToImage<GeometryScanline>(ras, nullptr, expect), 0);
+    for (int32_t y = 0; y < HEIGHT; y++) {
+        for (int32_t x = 0; x < WIDTH; x++) {
+            if (!InRects(rects, numRects, x, y)) {
+                expect[y * WIDTH + x] = 0;
+            }
+        }
+    }
+
+    // Without the clip box of the region, the covers inside are the unclipped ones
+    ASSERT_GT(SweepToImage<GeometryScanline>(ras, &region, image), 0);
+    EXPECT_EQ(memcmp(image, expect, WIDTH * HEIGHT), 0);
+    ASSERT_GT(SweepToImage<GeometryScanlinePacked>(ras, &region, image), 0);
+    EXPECT_EQ(memcmp(image, expect, WIDTH * HEIGHT), 0);
+
+    RasterizerScanlineAntialias clipped;
+    region.ApplyClipBox(clipped);
+    AddStar(clipped);
+    ASSERT_GT(SweepToImage<GeometryScanlinePacked>(clipped, &region, image), 0);
+    for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+        ASSERT_LE(abs(image[i] - expect[i]), CLIP_BOX_TOLERANCE) << i % WIDTH << ", " << i / WIDTH;
+    }
+}
+} // namespace OHOS
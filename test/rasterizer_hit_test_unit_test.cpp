@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_hit_test.h"
+
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const float SIZE = 100.0f;
+    const float HALF = 50.0f;
+    const uint32_t MAX_ROWS = RasterizerHitTest::HIT_MAX_ROWS;
+
+    /*
+     * A rectangle whose left and right sides are split into segments edges each,
+     * so that it has 2 * segments edges, clockwise in y-down coordinates or not.
+     */
+    void AddRect(RasterizerHitTest& hit, float left, float top, float right, float bottom,
+                 uint32_t segments, bool clockwise)
+    {
+        float step = (bottom - top) / segments;
+        float first = clockwise ? right : left;
+        float second = clockwise ? left : right;
+        hit.MoveTo(first, top);
+        for (uint32_t i = 1; i <= segments; i++) {
+            hit.LineTo(first, top + step * i);
+        }
+        hit.LineTo(second, bottom);
+        for (uint32_t i = segments; i > 0; i--) {
+            hit.LineTo(second, top + step * (i - 1));
+        }
+        hit.ClosePolygon();
+    }
+
+    /*
+     * Test points on both sides of every row of the index, of the left and right sides
+     * and of the top and bottom of a rectangle, which covers [left, right) x [top, bottom).
+     * The points near the rectangle but not in it hit as outside tells, e.g. true inside an outer rectangle.
+     */
+    void ExpectRect(RasterizerHitTest& hit, float left, float top, float right, float bottom,
+                    bool inside, bool outside)
+    {
+        uint32_t numRows = hit.GetNumEdges() < MAX_ROWS ? hit.GetNumEdges() : MAX_ROWS;
+        float rowHeight = (bottom - top) / numRows;
+        const float xs[] = {left - 1.0f, left, left + 0.5f, (left + right) * 0.5f, right - 0.5f, right, right + 1.0f};
+        for (uint32_t row = 0; row <= numRows; row++) {
+            float ys[] = {top + rowHeight * row - 0.25f, top + rowHeight * row, top + rowHeight * row + 0.25f};
+            for (float y : ys) {
+                for (float x : xs) {
+                    bool expect = (x >= left && x < right && y >= top && y < bottom) ? inside : outside;
+                    ASSERT_EQ(hit.HitTest(x, y), expect) << hit.GetNumEdges() << " edges at " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+class RasterizerHitTestTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerHitTest_001
+ * @tc.desc: Verify points inside, outside and on the edges of a square, with both filling rules.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerHitTestTest, RasterizerHitTest_001, TestSize.Level0)
+{
+    RasterizerHitTest hit;
+    EXPECT_FALSE(hit.HitTest(HALF, HALF));
+    AddRect(hit, 0, 0, SIZE, SIZE, 1, true);
+    EXPECT_EQ(hit.GetNumEdges(), 2u); // 2: the horizontal edges are dropped
+
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    for (FillingRule rule : rules) {
+        hit.SetFillingRule(rule);
+        EXPECT_TRUE(hit.HitTest(HALF, HALF));
+        EXPECT_FALSE(hit.HitTest(-HALF, HALF));
+        EXPECT_FALSE(hit.HitTest(SIZE + HALF, HALF));
+        EXPECT_FALSE(hit.HitTest(HALF, -HALF));
+        EXPECT_FALSE(hit.HitTest(HALF, SIZE + HALF));
+        // The left and top edges are inside, the right and bottom edges outside
+        EXPECT_TRUE(hit.HitTest(0, HALF));
+        EXPECT_TRUE(hit.HitTest(HALF, 0));
+        EXPECT_TRUE(hit.HitTest(0, 0));
+        EXPECT_FALSE(hit.HitTest(SIZE, HALF));
+        EXPECT_FALSE(hit.HitTest(HALF, SIZE));
+        EXPECT_FALSE(hit.HitTest(SIZE, SIZE));
+    }
+    EXPECT_EQ(hit.GetWindingNumber(HALF, HALF), 1);
+
+    hit.Reset();
+    EXPECT_FALSE(hit.HitTest(HALF, HALF));
+}
+
+/**
+ * @tc.name: RasterizerHitTest_002
+ * @tc.desc: Verify points on both sides of and on a slanted edge.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerHitTestTest, RasterizerHitTest_002, TestSize.Level0)
+{
+    RasterizerHitTest hit;
+    hit.MoveTo(0, 0);
+    hit.LineTo(SIZE, SIZE);
+    hit.LineTo(0, SIZE);
+
+    EXPECT_TRUE(hit.HitTest(HALF - 1.0f, HALF));
+    EXPECT_FALSE(hit.HitTest(HALF + 1.0f, HALF));
+    // The slanted edge is on the right of the triangle, so it is outside
+    EXPECT_FALSE(hit.HitTest(HALF, HALF));
+    EXPECT_EQ(hit.GetWindingNumber(HALF - 1.0f, HALF), 1);
+}
+
+/**
+ * @tc.name: RasterizerHitTest_003
+ * @tc.desc: Verify points across every row of the index, with fewer and more edges than HIT_MAX_ROWS.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerHitTestTest, RasterizerHitTest_003, TestSize.Level0)
+{
+    const uint32_t segments[] = {1, MAX_ROWS / 2 - 1, MAX_ROWS / 2, MAX_ROWS / 2 + 1, MAX_ROWS * 2};
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    for (uint32_t num : segments) {
+        for (FillingRule rule : rules) {
+            RasterizerHitTest hit;
+            hit.SetFillingRule(rule);
+            AddRect(hit, 0, 0, SIZE, SIZE, num, false);
+            EXPECT_EQ(hit.GetNumEdges(), num * 2); // 2: the left and right sides
+            ExpectRect(hit, 0, 0, SIZE, SIZE, true, false);
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerHitTest_004
+ * @tc.desc: Verify the filling rules differ inside a square nested in another of the same direction.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerHitTestTest, RasterizerHitTest_004, TestSize.Level0)
+{
+    const uint32_t segments[] = {1, MAX_ROWS};
+    for (uint32_t num : segments) {
+        RasterizerHitTest hit;
+        AddRect(hit, 0, 0, SIZE, SIZE, num, true);
+        AddRect(hit, HALF / 2, HALF / 2, SIZE - HALF / 2, SIZE - HALF / 2, num, true); // 2: a quarter
+
+        EXPECT_EQ(hit.GetWindingNumber(HALF, HALF), 2); // 2: twice clockwise
+        hit.SetFillingRule(FILL_NON_ZERO);
+        ExpectRect(hit, HALF / 2, HALF / 2, SIZE - HALF / 2, SIZE - HALF / 2, true, true); // 2: a quarter
+        EXPECT_TRUE(hit.HitTest(1.0f, HALF));
+        EXPECT_FALSE(hit.HitTest(SIZE + 1.0f, HALF));
+
+        hit.SetFillingRule(FILL_EVEN_ODD);
+        ExpectRect(hit, HALF / 2, HALF / 2, SIZE - HALF / 2, SIZE - HALF / 2, false, true); // 2: a quarter
+        EXPECT_TRUE(hit.HitTest(1.0f, HALF));
+        EXPECT_FALSE(hit.HitTest(SIZE + 1.0f, HALF));
+    }
+}
+
+/**
+ * @tc.name: RasterizerHitTest_005
+ * @tc.desc: Verify a square nested in another of the opposite direction is a hole under both filling rules.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerHitTestTest, RasterizerHitTest_005, TestSize.Level0)
+{
+    const uint32_t segments[] = {1, MAX_ROWS};
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    for (uint32_t num : segments) {
+        for (FillingRule rule : rules) {
+            RasterizerHitTest hit;
+            hit.SetFillingRule(rule);
+            AddRect(hit, 0, 0, SIZE, SIZE, num, true);
+            AddRect(hit, HALF / 2, HALF / 2, SIZE - HALF / 2, SIZE - HALF / 2, num, false); // 2: a quarter
+            ExpectRect(hit, HALF / 2, HALF / 2, SIZE - HALF / 2, SIZE - HALF / 2, false, true); // 2: a quarter
+            EXPECT_TRUE(hit.HitTest(1.0f, HALF));
+            EXPECT_TRUE(hit.HitTest(HALF, 1.0f));
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,1160 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_storage.h"
+#include "securec.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t WIDTH = 256;
+    const int32_t HEIGHT = 256;
+    const uint32_t NUM_PATHS = 6;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    const float PI = 3.14159265f;
+    // Enough cell blocks for every cell of the largest path, which passes the default limit
+    const uint32_t ALL_CELL_BLOCKS = 1 << 14;
+    // RasterizerCellsAntiAlias::CELL_BLOCK_SIZE
+    const uint32_t CELL_BLOCK_CELLS = 32;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // A point in [margin, size - margin) with a fraction of 1 / 64 pixel
+    float RandomCoord(uint32_t& seed, int32_t size, int32_t margin)
+    {
+        const uint32_t fraction = 64;
+        uint32_t range = static_cast<uint32_t>(size - margin * 2) * fraction;
+        return margin + static_cast<float>(NextRandom(seed) % range) / fraction;
+    }
+
+    template <class Rasterizer>
+    void AddPolygon(Rasterizer& ras, uint32_t seed, uint32_t numVertices, int32_t margin)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, WIDTH, margin);
+            float y = RandomCoord(seed, HEIGHT, margin);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    template <class Rasterizer>
+    void AddStar(Rasterizer& ras, float centerX, float centerY, float radius, uint32_t points)
+    {
+        for (uint32_t i = 0; i < points * 2; i++) {
+            float angle = PI * i / points;
+            float r = (i & 1) ? radius * 0.4f : radius; // 0.4: the inner radius
+            float x = centerX + r * cosf(angle);
+            float y = centerY + r * sinf(angle);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    /*
+     * The fixed paths of the tests: a triangle, a rectangle with a hole, stars, and random polygons
+     * from a few to crowded scanlines of several hundred cells.
+     */
+    template <class Rasterizer>
+    void AddTestPath(Rasterizer& ras, uint32_t index)
+    {
+        switch (index) {
+            case 0: // 0: a triangle
+                ras.MoveToByfloat(10.5f, 20.25f);
+                ras.LineToByfloat(200.75f, 60.5f);
+                ras.LineToByfloat(80.25f, 230.75f);
+                ras.ClosePolygon();
+                break;
+            case 1: // 1: a rectangle with a hole of the opposite direction
+                ras.MoveToByfloat(20.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 236.0f);
+                ras.LineToByfloat(20.0f, 236.0f);
+                ras.ClosePolygon();
+                ras.MoveToByfloat(60.5f, 60.5f);
+                ras.LineToByfloat(60.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 60.5f);
+                ras.ClosePolygon();
+                break;
+            case 2: // 2: stars
+                AddStar(ras, 128.0f, 128.0f, 120.0f, 7);   // 128: center, 120: radius, 7: points
+                AddStar(ras, 64.3f, 70.7f, 50.0f, 23);     // 64.3, 70.7: center, 50: radius, 23: points
+                break;
+            case 3: // 3: a few vertices
+                AddPolygon(ras, 11, 7, 1); // 11: seed, 7: vertices, 1: margin
+                break;
+            case 4: // 4: hundreds of cells per scanline
+                AddPolygon(ras, 12, 150, 1); // 12: seed, 150: vertices, 1: margin
+                break;
+            default:
+                AddPolygon(ras, 13, 1000, 1); // 13: seed, 1000: vertices, 1: margin
+                break;
+        }
+    }
+
+    /*
+     * Sweep the rasterizer, or a scanline storage replaying it, into an image of WIDTH x HEIGHT alphas.
+     * @return The number of scanlines, or -1 for a scanline out of the image or out of order.
+     */
+    template <class Rasterizer, class Scanline>
+    int32_t SweepToImage(Rasterizer& ras, Scanline& sl, uint8_t* image)
+    {
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        if (!ras.RewindScanlines()) {
+            return 0;
+        }
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        int32_t lastY = INT32_MIN;
+        while (ras.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            if (y <= lastY || y < 0 || y >= HEIGHT) {
+                return -1;
+            }
+            lastY = y;
+            numScanlines++;
+            typename Scanline::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                int32_t length = span->spanLength;
+                bool solid = length < 0;
+                length = solid ? -length : length;
+                if (span->x < 0 || span->x + length > WIDTH) {
+                    return -1;
+                }
+                for (int32_t k = 0; k < length; k++) {
+                    image[y * WIDTH + span->x + k] = solid ? *span->covers : span->covers[k];
+                }
+            }
+        }
+        return numScanlines;
+    }
+
+    template <class Rasterizer>
+    int32_t SweepToImage(Rasterizer& ras, uint8_t* image)
+    {
+        GeometryScanline sl;
+        return SweepToImage(ras, sl, image);
+    }
+
+    // Sweep a path with a new rasterizer without a cell budget, so that the largest path keeps all of its cells
+    int32_t SweepFreshToImage(uint32_t path, uint8_t* image)
+    {
+        RasterizerScanlineAntialias ras;
+        ras.SetCellBudget(0);
+        AddTestPath(ras, path);
+        return SweepToImage(ras, image);
+    }
+
+    // The lines of a path straight into the cells, as the rasterizer builds them without a clip box
+    class OutlinePath {
+    public:
+        OutlinePath() : outline_(ALL_CELL_BLOCKS) {}
+
+        void MoveToByfloat(float x, float y)
+        {
+            ClosePolygon();
+            startX_ = lastX_ = RasterDepictInt::UpScale(x);
+            startY_ = lastY_ = RasterDepictInt::UpScale(y);
+        }
+
+        void LineToByfloat(float x, float y)
+        {
+            int32_t nextX = RasterDepictInt::UpScale(x);
+            int32_t nextY = RasterDepictInt::UpScale(y);
+            outline_.LineOperate(lastX_, lastY_, nextX, nextY);
+            lastX_ = nextX;
+            lastY_ = nextY;
+        }
+
+        void ClosePolygon()
+        {
+            if (lastX_ != startX_ || lastY_ != startY_) {
+                outline_.LineOperate(lastX_, lastY_, startX_, startY_);
+                lastX_ = startX_;
+                lastY_ = startY_;
+            }
+        }
+
+        RasterizerCellsAntiAlias& GetOutline()
+        {
+            return outline_;
+        }
+
+    private:
+        RasterizerCellsAntiAlias outline_;
+        int32_t startX_ = 0;
+        int32_t startY_ = 0;
+        int32_t lastX_ = 0;
+        int32_t lastY_ = 0;
+    };
+
+    /*
+     * Sweep the cells of a path one by one into an image, as SweepCells does without the dense row.
+     * @return The number of scanlines, and the number of rows crowded enough for the dense row.
+     */
+    int32_t SweepCellsToImage(OutlinePath& path, const RasterizerScanlineAntialias& ras, uint8_t* image,
+                              uint32_t& numDenseRows)
+    {
+        numDenseRows = 0;
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        path.ClosePolygon();
+        RasterizerCellsAntiAlias& outline = path.GetOutline();
+        outline.SortAllCells();
+        int32_t numScanlines = 0;
+        for (int32_t y = outline.GetMinY(); outline.GetTotalCells() > 0 && y <= outline.GetMaxY(); y++) {
+            uint32_t numCells = outline.GetScanlineNumCells(y);
+            const CellBuildAntiAlias* const* cells = outline.GetScanlineCells(y);
+            if (numCells >= RasterizerScanlineAntialias::DENSE_ROW_MIN_CELLS &&
+                static_cast<uint32_t>(cells[numCells - 1]->x - cells[0]->x) + 1 <=
+                numCells * RasterizerScanlineAntialias::DENSE_ROW_RATIO) {
+                numDenseRows++;
+            }
+            bool covered = false;
+            int32_t cover = 0;
+            uint32_t i = 0;
+            while (i < numCells) {
+                int32_t x = cells[i]->x;
+                int32_t area = 0;
+                for (; i < numCells && cells[i]->x == x; i++) {
+                    area += cells[i]->area;
+                    cover += cells[i]->cover;
+                }
+                uint8_t alpha = ras.CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
+                if (area != 0) {
+                    image[y * WIDTH + x] = alpha;
+                    covered = covered || (alpha != 0);
+                    x++;
+                }
+                alpha = ras.CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
+                for (; i < numCells && x < cells[i]->x; x++) {
+                    image[y * WIDTH + x] = alpha;
+                    covered = covered || (alpha != 0);
+                }
+            }
+            numScanlines += covered ? 1 : 0;
+        }
+        return numScanlines;
+    }
+
+    // A random polygon in a square, as a vertex source with the bounds of its vertices
+    class PolygonSource {
+    public:
+        PolygonSource(uint32_t& seed, float left, float top, float size)
+            : numVertices_(3 + NextRandom(seed) % (MAX_VERTICES - 2)), // 3, 2: from a triangle to MAX_VERTICES
+              index_(0), minX_(left + size), minY_(top + size), maxX_(left), maxY_(top)
+        {
+            const uint32_t fraction = 64;
+            for (uint32_t i = 0; i < numVertices_; i++) {
+                x_[i] = left + static_cast<float>(NextRandom(seed) % static_cast<uint32_t>(size * fraction)) / fraction;
+                y_[i] = top + static_cast<float>(NextRandom(seed) % static_cast<uint32_t>(size * fraction)) / fraction;
+                minX_ = MATH_MIN(minX_, x_[i]);
+                minY_ = MATH_MIN(minY_, y_[i]);
+                maxX_ = MATH_MAX(maxX_, x_[i]);
+                maxY_ = MATH_MAX(maxY_, y_[i]);
+            }
+        }
+
+        void Rewind(uint32_t)
+        {
+            index_ = 0;
+        }
+
+        uint32_t GenerateVertex(float* x, float* y)
+        {
+            if (index_ > numVertices_) {
+                return PATH_CMD_STOP;
+            }
+            if (index_ == numVertices_) {
+                index_++;
+                return PATH_CMD_END_POLY | PATH_FLAGS_CLOSE;
+            }
+            *x = x_[index_];
+            *y = y_[index_];
+            return (index_++ == 0) ? PATH_CMD_MOVE_TO : PATH_CMD_LINE_TO;
+        }
+
+        template <class Rasterizer>
+        bool AddCulled(Rasterizer& ras)
+        {
+            return ras.AddPathCulled(*this, minX_, minY_, maxX_, maxY_);
+        }
+
+    private:
+        static const uint32_t MAX_VERTICES = 8;
+        float x_[MAX_VERTICES];
+        float y_[MAX_VERTICES];
+        uint32_t numVertices_;
+        uint32_t index_;
+        float minX_;
+        float minY_;
+        float maxX_;
+        float maxY_;
+    };
+
+    // A random polygon over width x height pixels, past the image of the other paths
+    void AddLargePolygon(RasterizerScanlineAntialias& ras, uint32_t seed, uint32_t numVertices,
+                         int32_t width, int32_t height)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, width, 0);
+            float y = RandomCoord(seed, height, 0);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    // Whether two rasterizers sweep the same spans with the same covers, row after row
+    bool SameSweeps(RasterizerScanlineAntialias& ras, RasterizerScanlineAntialias& other)
+    {
+        bool rewound = ras.RewindScanlines();
+        if (rewound != other.RewindScanlines()) {
+            return false;
+        }
+        if (!rewound) {
+            return true;
+        }
+        GeometryScanline sl;
+        GeometryScanline otherSl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        otherSl.Reset(other.GetMinX(), other.GetMaxX());
+        while (ras.SweepScanline(sl)) {
+            if (!other.SweepScanline(otherSl) || sl.GetYLevel() != otherSl.GetYLevel() ||
+                sl.NumSpans() != otherSl.NumSpans()) {
+                return false;
+            }
+            GeometryScanline::ConstIterator span = sl.Begin();
+            GeometryScanline::ConstIterator otherSpan = otherSl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++, otherSpan++) {
+                if (span->x != otherSpan->x || span->spanLength != otherSpan->spanLength ||
+                    memcmp(span->covers, otherSpan->covers, span->spanLength) != 0) {
+                    return false;
+                }
+            }
+        }
+        return !other.SweepScanline(otherSl);
+    }
+
+    uint32_t CountDiffs(const uint8_t* image, const uint8_t* expect)
+    {
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (image[i] != expect[i]) ? 1 : 0;
+        }
+        return diffs;
+    }
+}
+
+class RasterizerScanlineAntialiasTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerScanlineSortByValue_001
+ * @tc.desc: Verify the cells sorted by value sweep the same scanlines as the cells sorted by pointer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineSortByValue_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias byPointer;
+    RasterizerScanlineAntialias byValue;
+    byValue.SortByValue(true);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        AddTestPath(byPointer, path);
+        int32_t numScanlines = SweepToImage(byPointer, expect);
+        EXPECT_GT(numScanlines, 0);
+        byPointer.Reset();
+
+        AddTestPath(byValue, path);
+        EXPECT_EQ(SweepToImage(byValue, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        byValue.Reset();
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineSortByValue_002
+ * @tc.desc: Verify switching the sort mode resets the rasterizer and takes effect on the next path.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineSortByValue_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias ras;
+    AddTestPath(ras, 4); // 4: a crowded path
+    int32_t numScanlines = SweepToImage(ras, expect);
+
+    AddTestPath(ras, 2); // 2: a path dropped by the switch
+    ras.SortByValue(true);
+    AddTestPath(ras, 4); // 4: a crowded path
+    EXPECT_EQ(SweepToImage(ras, image), numScanlines);
+    EXPECT_EQ(CountDiffs(image, expect), 0u);
+
+    ras.SortByValue(false);
+    AddTestPath(ras, 4); // 4: a crowded path
+    EXPECT_EQ(SweepToImage(ras, image), numScanlines);
+    EXPECT_EQ(CountDiffs(image, expect), 0u);
+}
+
+/**
+ * @tc.name: RasterizerScanlineReuse_001
+ * @tc.desc: Verify the buffers kept across Reset, and trimmed by ShrinkToFit, sweep as a new rasterizer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineReuse_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    // From the largest path to the smallest and back, so that the buffers shrink and grow
+    const uint32_t paths[] = {5, 0, 3, 5, 4, 1, 2, 5};
+    const bool byValue[] = {false, true};
+    for (bool value : byValue) {
+        RasterizerScanlineAntialias ras;
+        ras.SetCellBudget(0);
+        ras.SortByValue(value);
+        uint32_t step = 0;
+        for (uint32_t path : paths) {
+            int32_t numScanlines = SweepFreshToImage(path, expect);
+            AddTestPath(ras, path);
+            EXPECT_EQ(SweepToImage(ras, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+            if ((++step % 2) == 0) { // 2: trim every other path
+                ras.ShrinkToFit();
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineReuse_002
+ * @tc.desc: Verify ShrinkToFit keeps the buffers of the path being swept.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineReuse_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias ras;
+    ras.SetCellBudget(0);
+    AddTestPath(ras, 5); // 5: the largest path
+    SweepToImage(ras, image);
+
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        int32_t numScanlines = SweepFreshToImage(path, expect);
+        AddTestPath(ras, path);
+        ASSERT_TRUE(ras.RewindScanlines());
+        ras.ShrinkToFit();
+        EXPECT_EQ(SweepToImage(ras, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineDenseRow_001
+ * @tc.desc: Verify the crowded rows swept through the dense row match the cells swept one by one.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineDenseRow_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const bool byValue[] = {false, true};
+    uint32_t totalDenseRows = 0;
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        for (bool value : byValue) {
+            RasterizerScanlineAntialias ras;
+            ras.SetCellBudget(0);
+            ras.SortByValue(value);
+            OutlinePath cells;
+            AddTestPath(cells, path);
+            uint32_t numDenseRows = 0;
+            int32_t numScanlines = SweepCellsToImage(cells, ras, expect, numDenseRows);
+            totalDenseRows += numDenseRows;
+
+            AddTestPath(ras, path);
+            EXPECT_EQ(SweepToImage(ras, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        }
+    }
+    // The crowded paths have rows swept through the dense row
+    EXPECT_GT(totalDenseRows, 0u);
+}
+
+/**
+ * @tc.name: RasterizerScanlineDense_001
+ * @tc.desc: Verify dense accumulation sweeps the same scanlines as the cell list, path after path.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineDense_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias dense;
+    dense.AccumulateDense(true);
+    // From the largest path to the smallest and back, so that the dense box shrinks and grows
+    const uint32_t paths[] = {0, 1, 2, 3, 4, 5, 3, 0, 5, 2};
+    for (uint32_t path : paths) {
+        RasterizerScanlineAntialias cells(ALL_CELL_BLOCKS);
+        AddTestPath(cells, path);
+        int32_t numScanlines = SweepToImage(cells, expect);
+        AddTestPath(dense, path);
+        EXPECT_EQ(SweepToImage(dense, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        // A second sweep of the same rows
+        EXPECT_EQ(SweepToImage(dense, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineDense_002
+ * @tc.desc: Verify dense accumulation of clipped paths, and of several paths in one box, matches the cell list.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineDense_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias cells(ALL_CELL_BLOCKS);
+    RasterizerScanlineAntialias dense;
+    dense.AccumulateDense(true);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        cells.ClipBox(30.0f, 70.0f, 200.0f, 180.0f); // 30, 70, 200, 180: the clip box
+        dense.ClipBox(30.0f, 70.0f, 200.0f, 180.0f); // 30, 70, 200, 180: the clip box
+        AddTestPath(cells, path);
+        AddTestPath(dense, path);
+        int32_t numScanlines = SweepToImage(cells, expect);
+        EXPECT_EQ(SweepToImage(dense, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+    }
+
+    // The box of the first path grows to hold the others
+    cells.ResetClipping();
+    dense.ResetClipping();
+    const uint32_t paths[] = {3, 0, 2};
+    for (uint32_t path : paths) {
+        AddTestPath(cells, path);
+        AddTestPath(dense, path);
+    }
+    int32_t numScanlines = SweepToImage(cells, expect);
+    EXPECT_EQ(SweepToImage(dense, image), numScanlines);
+    EXPECT_EQ(CountDiffs(image, expect), 0u);
+}
+
+/**
+ * @tc.name: RasterizerScanlineDense_003
+ * @tc.desc: Verify PreferDenseAccumulate picks small boxes with many edges.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineDense_003, TestSize.Level0)
+{
+    EXPECT_FALSE(RasterizerScanlineAntialias::PreferDenseAccumulate(0, 10, 10));  // 10: height and edges
+    EXPECT_FALSE(RasterizerScanlineAntialias::PreferDenseAccumulate(10, 0, 10));  // 10: width and edges
+    EXPECT_TRUE(RasterizerScanlineAntialias::PreferDenseAccumulate(16, 16, 4));   // 16: width and height, 4: edges
+    EXPECT_FALSE(RasterizerScanlineAntialias::PreferDenseAccumulate(256, 256, 4)); // 256: a large box
+    EXPECT_FALSE(RasterizerScanlineAntialias::PreferDenseAccumulate(1024, 1024, 100000)); // 1024: beyond the limit
+}
+
+/**
+ * @tc.name: RasterizerScanlineDense_004
+ * @tc.desc: Verify paths whose box is over the dense box limit spill to the cell list and match it,
+ *           with and without a cell budget.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineDense_004, TestSize.Level0)
+{
+    // 4000 x 3400: over DENSE_BOX_LIMIT pixels, 2100 x 2000: over it once the box grows by half
+    const int32_t sizes[][2] = {{600, 500}, {2100, 2000}, {4000, 3400}};
+    const uint32_t vertices[] = {20, 200};
+    // 0: no budget, 2048: a budget the larger paths go over
+    const uint32_t budgets[] = {0, 2048};
+    uint32_t seed = 6; // 6: seed
+    for (const int32_t* size : sizes) {
+        for (uint32_t numVertices : vertices) {
+            for (uint32_t budget : budgets) {
+                RasterizerScanlineAntialias cells;
+                cells.SetCellBudget(budget);
+                RasterizerScanlineAntialias dense;
+                dense.SetCellBudget(budget);
+                dense.AccumulateDense(true);
+                AddLargePolygon(cells, seed, numVertices, size[0], size[1]);
+                AddLargePolygon(dense, seed, numVertices, size[0], size[1]);
+                EXPECT_TRUE(SameSweeps(dense, cells))
+                    << size[0] << " x " << size[1] << " vertices " << numVertices << " budget " << budget;
+                seed++;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineGamma_001
+ * @tc.desc: Verify the gamma tables of the curves, and the clamping of a custom curve.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineGamma_001, TestSize.Level0)
+{
+    const uint32_t mask = RasterizerScanlineAntialias::AA_MASK;
+    RasterizerScanlineAntialias ras;
+    for (uint32_t cover = 0; cover <= mask; cover++) {
+        EXPECT_EQ(ras.ApplyGamma(cover), cover);
+    }
+
+    ras.Gamma(GammaPower(2.2f)); // 2.2: gamma
+    for (uint32_t cover = 0; cover <= mask; cover++) {
+        float expect = std::pow(static_cast<float>(cover) / mask, 2.2f) * mask; // 2.2: gamma
+        EXPECT_NEAR(static_cast<float>(ras.ApplyGamma(cover)), expect, 0.5f) << cover;
+    }
+    EXPECT_EQ(ras.ApplyGamma(0), 0u);
+    EXPECT_EQ(ras.ApplyGamma(mask), mask);
+
+    ras.Gamma(GammaThreshold(0.5f)); // 0.5: threshold
+    for (uint32_t cover = 0; cover <= mask; cover++) {
+        EXPECT_EQ(ras.ApplyGamma(cover), (cover * 2 < mask) ? 0u : mask) << cover; // 2: half of mask
+    }
+
+    ras.Gamma(GammaLinear(0.2f, 0.8f)); // 0.2, 0.8: the start and end of the ramp
+    EXPECT_EQ(ras.ApplyGamma(51), 0u);      // 51: 0.2 of mask
+    EXPECT_EQ(ras.ApplyGamma(128), 128u);   // 128: the middle stays
+    EXPECT_EQ(ras.ApplyGamma(204), mask);   // 204: 0.8 of mask
+    EXPECT_EQ(ras.ApplyGamma(mask), mask);
+
+    // Out of [0, 1] is clamped to the table range
+    ras.Gamma([](float x) { return x * 2.0f - 0.5f; }); // 2, 0.5: a curve out of range at both ends
+    EXPECT_EQ(ras.ApplyGamma(0), 0u);
+    EXPECT_EQ(ras.ApplyGamma(mask), mask);
+
+    ras.Gamma(GammaNone());
+    for (uint32_t cover = 0; cover <= mask; cover++) {
+        EXPECT_EQ(ras.ApplyGamma(cover), cover);
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineGamma_002
+ * @tc.desc: Verify the swept alphas with a gamma curve are the alphas without it looked up in the gamma table.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineGamma_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias power;
+    power.Gamma(GammaPower(0.5f)); // 0.5: gamma
+    RasterizerScanlineAntialias threshold;
+    threshold.Gamma(GammaThreshold(0.3f)); // 0.3: threshold
+    RasterizerScanlineAntialias* curves[] = {&power, &threshold};
+    for (RasterizerScanlineAntialias* ras : curves) {
+        ras->SetCellBudget(0);
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            SweepFreshToImage(path, expect);
+            AddTestPath(*ras, path);
+            EXPECT_GT(SweepToImage(*ras, image), 0) << "path " << path;
+            uint32_t diffs = 0;
+            for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+                diffs += (image[i] != ras->ApplyGamma(expect[i])) ? 1 : 0;
+            }
+            EXPECT_EQ(diffs, 0u) << "path " << path;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineCull_001
+ * @tc.desc: Verify IsPathVisible of bounds on every side of the clip box, and without a clip box.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineCull_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    EXPECT_TRUE(ras.IsPathVisible(-1000.0f, -1000.0f, -900.0f, -900.0f)); // -1000, -900: far away
+
+    ras.ClipBox(30.0f, 70.0f, 200.0f, 180.0f); // 30, 70, 200, 180: the clip box
+    EXPECT_TRUE(ras.IsPathVisible(0.0f, 0.0f, 256.0f, 256.0f));    // 256: around the clip box
+    EXPECT_TRUE(ras.IsPathVisible(100.0f, 100.0f, 110.0f, 110.0f)); // 100, 110: inside
+    EXPECT_TRUE(ras.IsPathVisible(10.0f, 60.0f, 30.0f, 70.0f));     // 10, 60: touching the top left corner
+    EXPECT_TRUE(ras.IsPathVisible(210.0f, 190.0f, 200.0f, 180.0f)); // 210, 190: touching, reversed bounds
+    EXPECT_FALSE(ras.IsPathVisible(0.0f, 100.0f, 29.5f, 110.0f));   // 29.5: left
+    EXPECT_FALSE(ras.IsPathVisible(200.5f, 100.0f, 250.0f, 110.0f)); // 200.5: right
+    EXPECT_FALSE(ras.IsPathVisible(100.0f, 0.0f, 110.0f, 69.5f));   // 69.5: above
+    EXPECT_FALSE(ras.IsPathVisible(100.0f, 180.5f, 110.0f, 250.0f)); // 180.5: below
+
+    ras.ResetClipping();
+    EXPECT_TRUE(ras.IsPathVisible(0.0f, 100.0f, 29.5f, 110.0f)); // 29.5: left of the former clip box
+}
+
+/**
+ * @tc.name: RasterizerScanlineCull_002
+ * @tc.desc: Verify the paths added by AddPathCulled sweep as the same paths added by AddPath.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineCull_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias all;
+    RasterizerScanlineAntialias culled;
+    all.ClipBox(30.0f, 70.0f, 200.0f, 180.0f);    // 30, 70, 200, 180: the clip box
+    culled.ClipBox(30.0f, 70.0f, 200.0f, 180.0f); // 30, 70, 200, 180: the clip box
+    uint32_t seed = 17; // 17: seed
+    uint32_t numCulled = 0;
+    for (uint32_t i = 0; i < 60; i++) { // 60: paths
+        // Squares of 60 pixels from -100 to 300, on all sides of the clip box
+        float left = static_cast<float>(NextRandom(seed) % 400) - 100.0f;
+        float top = static_cast<float>(NextRandom(seed) % 400) - 100.0f;
+        PolygonSource polygon(seed, left, top, 60.0f);
+        all.AddPath(polygon);
+        numCulled += polygon.AddCulled(culled) ? 0 : 1;
+    }
+    EXPECT_GT(numCulled, 0u);
+    int32_t numScanlines = SweepToImage(all, expect);
+    EXPECT_GT(numScanlines, 0);
+    EXPECT_EQ(SweepToImage(culled, image), numScanlines);
+    EXPECT_EQ(CountDiffs(image, expect), 0u);
+}
+
+/**
+ * @tc.name: RasterizerScanlineBudget_001
+ * @tc.desc: Verify paths beyond the cell budget are swept band by band as the whole path without a budget.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBudget_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias whole;
+    whole.SetCellBudget(0);
+    // 40: about one row of the largest path per band, 128 and 512: more rows
+    const uint32_t budgets[] = {40, 128, 512};
+    for (uint32_t budget : budgets) {
+        uint32_t numBanded = 0;
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            AddTestPath(whole, path);
+            int32_t numScanlines = SweepToImage(whole, expect);
+            RasterizerScanlineAntialias banded;
+            banded.SetCellBudget(budget);
+            AddTestPath(banded, path);
+            EXPECT_EQ(SweepToImage(banded, image), numScanlines) << "path " << path << " budget " << budget;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path << " budget " << budget;
+            EXPECT_EQ(banded.GetMinX(), whole.GetMinX());
+            EXPECT_EQ(banded.GetMinY(), whole.GetMinY());
+            EXPECT_EQ(banded.GetMaxX(), whole.GetMaxX());
+            EXPECT_EQ(banded.GetMaxY(), whole.GetMaxY());
+            EXPECT_LE(banded.GetPeakCells(), budget * CELL_BLOCK_CELLS);
+            numBanded += banded.IsBanded() ? 1 : 0;
+        }
+        // The largest path goes over any of the budgets
+        EXPECT_GT(numBanded, 0u);
+    }
+    EXPECT_GT(whole.GetPeakCells(), 512u * CELL_BLOCK_CELLS); // 512: the largest budget
+}
+
+/**
+ * @tc.name: RasterizerScanlineBudget_003
+ * @tc.desc: Verify one rasterizer under a cell budget sweeps path after path as fresh ones,
+ *           after paths swept band by band.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBudget_003, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    // 40: the largest path is banded, 4: every path is banded, though the rows of the largest go over it
+    const uint32_t budgets[] = {40, 4};
+    const uint32_t paths[] = {0, 1, 2, 3, 4, 5, 3, 0, 5, 2};
+    for (uint32_t budget : budgets) {
+        RasterizerScanlineAntialias whole;
+        whole.SetCellBudget(0);
+        RasterizerScanlineAntialias banded;
+        banded.SetCellBudget(budget);
+        for (uint32_t path : paths) {
+            AddTestPath(whole, path);
+            AddTestPath(banded, path);
+            int32_t numScanlines = SweepToImage(whole, expect);
+            EXPECT_EQ(banded.RewindScanlines(), numScanlines > 0) << "path " << path << " budget " << budget;
+            EXPECT_EQ(banded.GetMinX(), whole.GetMinX()) << "path " << path << " budget " << budget;
+            EXPECT_EQ(banded.GetMinY(), whole.GetMinY()) << "path " << path << " budget " << budget;
+            EXPECT_EQ(banded.GetMaxX(), whole.GetMaxX()) << "path " << path << " budget " << budget;
+            EXPECT_EQ(banded.GetMaxY(), whole.GetMaxY()) << "path " << path << " budget " << budget;
+            if (budget * CELL_BLOCK_CELLS >= 1043) { // 1043: the cells of the most crowded row of the paths
+                EXPECT_EQ(SweepToImage(banded, image), numScanlines) << "path " << path << " budget " << budget;
+                EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path << " budget " << budget;
+            } else {
+                EXPECT_GE(SweepToImage(banded, image), 0) << "path " << path << " budget " << budget;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineBudget_002
+ * @tc.desc: Verify a tall path below a strip crowded over the cell budget is swept band by band as the whole path.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBudget_002, TestSize.Level0)
+{
+    RasterizerScanlineAntialias whole;
+    whole.SetCellBudget(0);
+    RasterizerScanlineAntialias banded;
+    banded.SetCellBudget(64); // 64: a budget the strip goes over in a few rows
+    for (RasterizerScanlineAntialias* ras : {&whole, &banded}) {
+        // A zigzag of 8 rows at the top, then down a side of 4000 rows
+        ras->MoveToByfloat(0.5f, 0.5f);
+        for (uint32_t i = 0; i < 400; i++) { // 400: teeth of the zigzag
+            ras->LineToByfloat(5.0f * i + 2.5f, (i & 1) ? 0.5f : 8.5f); // 5: pixels per tooth, 8.5: the strip
+        }
+        ras->LineToByfloat(2000.5f, 4000.5f); // 2000.5, 4000.5: the bottom corner
+        ras->LineToByfloat(0.5f, 4000.5f);    // 4000.5: the bottom
+        ras->ClosePolygon();
+    }
+    EXPECT_TRUE(SameSweeps(banded, whole));
+    EXPECT_TRUE(banded.IsBanded());
+    EXPECT_LE(banded.GetPeakCells(), 64u * CELL_BLOCK_CELLS); // 64: the budget
+}
+
+/**
+ * @tc.name: RasterizerScanlineBudget_004
+ * @tc.desc: Verify the budget of the constructor records no vertex and loses the cells beyond it, path after path,
+ *           while the same budget set by SetCellBudget sweeps the path band by band.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBudget_004, TestSize.Level0)
+{
+    const int32_t size = 900; // 900: a square larger than the image of the other paths
+    const uint32_t numVertices = 2000; // 2000: vertices whose cells go over the default budget
+    const uint32_t defaultBudget = 1 << (RasterizerScanlineAntialias::AA_SHIFT + 2);
+    RasterizerScanlineAntialias whole;
+    whole.SetCellBudget(0);
+    RasterizerScanlineAntialias unrecorded;
+    RasterizerScanlineAntialias recorded;
+    recorded.SetCellBudget(defaultBudget);
+    for (uint32_t i = 0; i < 2; i++) { // 2: a second path after one over the budget
+        AddLargePolygon(whole, 5, numVertices, size, size); // 5: seed
+        AddLargePolygon(unrecorded, 5, numVertices, size, size); // 5: seed
+        EXPECT_FALSE(SameSweeps(unrecorded, whole));
+        EXPECT_FALSE(unrecorded.IsBanded());
+
+        AddLargePolygon(whole, 5, numVertices, size, size); // 5: seed
+        AddLargePolygon(recorded, 5, numVertices, size, size); // 5: seed
+        EXPECT_TRUE(SameSweeps(recorded, whole));
+        EXPECT_TRUE(recorded.IsBanded());
+    }
+    EXPECT_LE(recorded.GetPeakCells(), defaultBudget * CELL_BLOCK_CELLS);
+}
+
+/**
+ * @tc.name: RasterizerScanlineBandRows_001
+ * @tc.desc: Verify SetBandRows sweeps the rows of the whole path within the band, and no other row.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBandRows_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const int32_t tops[] = {0, 37, 100, 200};
+    const int32_t bottoms[] = {36, 99, 130, 255};
+    RasterizerScanlineAntialias ras;
+    ras.SetCellBudget(0);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        SweepFreshToImage(path, expect);
+        for (uint32_t band = 0; band < sizeof(tops) / sizeof(tops[0]); band++) {
+            ras.SetBandRows(tops[band], bottoms[band]);
+            AddTestPath(ras, path);
+            EXPECT_GE(SweepToImage(ras, image), 0);
+            for (int32_t y = 0; y < HEIGHT; y++) {
+                bool inBand = y >= tops[band] && y <= bottoms[band];
+                for (int32_t x = 0; x < WIDTH; x++) {
+                    ASSERT_EQ(image[y * WIDTH + x], inBand ? expect[y * WIDTH + x] : 0)
+                        << "path " << path << " at " << x << ", " << y;
+                }
+            }
+            ras.Reset();
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineBandRows_002
+ * @tc.desc: Verify SetBandRows keeps the rows of a path over the cell budget within the band, band after band.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineBandRows_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const int32_t tops[] = {0, 37, 100, 200};
+    const int32_t bottoms[] = {36, 99, 130, 255};
+    // 40: about one row of the largest path per band, 128: more rows
+    const uint32_t budgets[] = {40, 128};
+    const uint32_t path = 5; // 5: the largest path, over the budgets
+    SweepFreshToImage(path, expect);
+    RasterizerScanlineAntialias ras;
+    for (uint32_t budget : budgets) {
+        ras.SetCellBudget(budget);
+        for (uint32_t band = 0; band < sizeof(tops) / sizeof(tops[0]); band++) {
+            ras.SetBandRows(tops[band], bottoms[band]);
+            AddTestPath(ras, path);
+            EXPECT_GE(SweepToImage(ras, image), 0);
+            for (int32_t y = 0; y < HEIGHT; y++) {
+                bool inBand = y >= tops[band] && y <= bottoms[band];
+                for (int32_t x = 0; x < WIDTH; x++) {
+                    ASSERT_EQ(image[y * WIDTH + x], inBand ? expect[y * WIDTH + x] : 0)
+                        << "budget " << budget << " band " << band << " at " << x << ", " << y;
+                }
+            }
+            ras.Reset();
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlinePacked_001
+ * @tc.desc: Verify the packed scanlines, with their solid spans, hold the alphas of the unpacked scanlines.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlinePacked_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias cells;
+    RasterizerScanlineAntialias byValue;
+    byValue.SortByValue(true);
+    RasterizerScanlineAntialias dense;
+    dense.AccumulateDense(true);
+    RasterizerScanlineAntialias* modes[] = {&cells, &byValue, &dense};
+    for (RasterizerScanlineAntialias* ras : modes) {
+        ras->SetCellBudget(0);
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            int32_t numScanlines = SweepFreshToImage(path, expect);
+            AddTestPath(*ras, path);
+            GeometryScanlinePacked sl;
+            EXPECT_EQ(SweepToImage(*ras, sl, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanline32_001
+ * @tc.desc: Verify the scanlines of 32 bit coordinates hold the alphas of the 16 bit scanlines in every mode.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanline32_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias cells;
+    RasterizerScanlineAntialias byValue;
+    byValue.SortByValue(true);
+    RasterizerScanlineAntialias dense;
+    dense.AccumulateDense(true);
+    RasterizerScanlineAntialias* modes[] = {&cells, &byValue, &dense};
+    for (RasterizerScanlineAntialias* ras : modes) {
+        ras->SetCellBudget(0);
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            int32_t numScanlines = SweepFreshToImage(path, expect);
+            AddTestPath(*ras, path);
+            GeometryScanline32 sl;
+            EXPECT_EQ(SweepToImage(*ras, sl, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+            GeometryScanlinePacked32 packed;
+            EXPECT_EQ(SweepToImage(*ras, packed, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanline32_002
+ * @tc.desc: Verify the spans of 32 bit coordinates reach beyond 32767 pixels.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanline32_002, TestSize.Level0)
+{
+    const float left = 40000.5f;  // 40000.5: beyond the 16 bit coordinates
+    const float right = 40010.5f; // 40010.5: 10 pixels wide
+    RasterizerScanlineAntialias ras;
+    ras.MoveToByfloat(left, 2.0f);  // 2: top
+    ras.LineToByfloat(right, 2.0f); // 2: top
+    ras.LineToByfloat(right, 3.0f); // 3: bottom
+    ras.LineToByfloat(left, 3.0f);  // 3: bottom
+    ras.ClosePolygon();
+    ASSERT_TRUE(ras.RewindScanlines());
+    GeometryScanline32 sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    ASSERT_TRUE(ras.SweepScanline(sl));
+    EXPECT_EQ(sl.GetYLevel(), 2); // 2: the row
+    ASSERT_EQ(sl.NumSpans(), 1u);
+    GeometryScanline32::ConstIterator span = sl.Begin();
+    EXPECT_EQ(span->x, 40000); // 40000: the first pixel
+    EXPECT_EQ(span->spanLength, 11); // 11: two half pixels and 9 full pixels
+    EXPECT_EQ(span->covers[0], span->covers[10]); // 10: the last pixel
+    EXPECT_EQ(span->covers[1], 255); // 255: full cover
+    EXPECT_FALSE(ras.SweepScanline(sl));
+
+    ASSERT_TRUE(ras.RewindScanlines());
+    GeometryScanlinePacked32 packed;
+    packed.Reset(ras.GetMinX(), ras.GetMaxX());
+    ASSERT_TRUE(ras.SweepScanline(packed));
+    ASSERT_EQ(packed.NumSpans(), 3u); // 3: the half pixels around a solid span
+    GeometryScanlinePacked32::ConstIterator solid = packed.Begin() + 1;
+    EXPECT_EQ(solid->x, 40001); // 40001: the first full pixel
+    EXPECT_EQ(solid->spanLength, -9); // -9: solid of 9 pixels
+}
+
+/**
+ * @tc.name: RasterizerScanlineStorage_001
+ * @tc.desc: Verify the scanlines recorded from packed and unpacked scanlines replay the sweep of the rasterizer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineStorage_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias ras;
+    ras.SetCellBudget(0);
+    GeometryScanlineStorage packedStorage;
+    GeometryScanlineStorage storage;
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        int32_t numScanlines = SweepFreshToImage(path, expect);
+        AddTestPath(ras, path);
+        GeometryScanlinePacked32 packed;
+        EXPECT_TRUE(packedStorage.Record(ras, packed));
+        GeometryScanline32 sl;
+        EXPECT_TRUE(storage.Record(ras, sl));
+        EXPECT_EQ(packedStorage.GetNumScanlines(), static_cast<uint32_t>(numScanlines)) << "path " << path;
+        EXPECT_EQ(storage.GetNumScanlines(), static_cast<uint32_t>(numScanlines)) << "path " << path;
+        EXPECT_GE(packedStorage.GetMinY(), ras.GetMinY()) << "path " << path;
+        EXPECT_LE(packedStorage.GetMaxY(), ras.GetMaxY()) << "path " << path;
+        EXPECT_LE(packedStorage.GetUsedMemorySize(), packedStorage.GetMemorySize()) << "path " << path;
+
+        // Twice, to replay after a rewind
+        for (uint32_t i = 0; i < 2; i++) { // 2: replays
+            EXPECT_EQ(SweepToImage(packedStorage, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+            EXPECT_EQ(SweepToImage(storage, image), numScanlines) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        }
+    }
+    ras.Reset();
+    GeometryScanline sl;
+    EXPECT_FALSE(storage.Record(ras, sl));
+    EXPECT_FALSE(storage.RewindScanlines());
+}
+
+/**
+ * @tc.name: RasterizerScanlineStorage_002
+ * @tc.desc: Verify a translation moves every replayed span and its bounds by whole pixels, keeping the covers.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineAntialiasTest, RasterizerScanlineStorage_002, TestSize.Level0)
+{
+    const int32_t dx = -300; // -300: to the left of the image
+    const int32_t dy = 1000; // 1000: below the image
+    RasterizerScanlineAntialias ras;
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        AddTestPath(ras, path);
+        GeometryScanlinePacked32 sl;
+        GeometryScanlineStorage storage;
+        GeometryScanlineStorage moved;
+        ASSERT_TRUE(storage.Record(ras, sl));
+        ASSERT_TRUE(moved.Record(ras, sl));
+        moved.SetTranslation(dx, dy);
+        EXPECT_EQ(moved.GetMinX(), storage.GetMinX() + dx);
+        EXPECT_EQ(moved.GetMinY(), storage.GetMinY() + dy);
+        EXPECT_EQ(moved.GetMaxX(), storage.GetMaxX() + dx);
+        EXPECT_EQ(moved.GetMaxY(), storage.GetMaxY() + dy);
+
+        GeometryScanlinePacked32 movedSl;
+        ASSERT_TRUE(storage.RewindScanlines());
+        ASSERT_TRUE(moved.RewindScanlines());
+        sl.Reset(storage.GetMinX(), storage.GetMaxX());
+        movedSl.Reset(moved.GetMinX(), moved.GetMaxX());
+        while (storage.SweepScanline(sl)) {
+            ASSERT_TRUE(moved.SweepScanline(movedSl));
+            ASSERT_EQ(movedSl.GetYLevel(), sl.GetYLevel() + dy);
+            ASSERT_EQ(movedSl.NumSpans(), sl.NumSpans());
+            GeometryScanlinePacked32::ConstIterator span = sl.Begin();
+            GeometryScanlinePacked32::ConstIterator movedSpan = movedSl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++, movedSpan++) {
+                ASSERT_EQ(movedSpan->x, span->x + dx);
+                ASSERT_EQ(movedSpan->spanLength, span->spanLength);
+                int32_t numCovers = (span->spanLength < 0) ? 1 : span->spanLength;
+                for (int32_t k = 0; k < numCovers; k++) {
+                    ASSERT_EQ(movedSpan->covers[k], span->covers[k]);
+                }
+            }
+        }
+        EXPECT_FALSE(moved.SweepScanline(movedSl));
+    }
+}
+} // namespace OHOS
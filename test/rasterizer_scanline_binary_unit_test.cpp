@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_binary.h"
+#include "securec.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t WIDTH = 256;
+    const int32_t HEIGHT = 256;
+    const uint32_t NUM_PATHS = 5;
+    const uint32_t MAX_EDGES = 256;
+    const uint8_t FULL_COVER = 255;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    const float PI = 3.14159265f;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // A point in [margin, size - margin) with a fraction of 1 / 64 pixel
+    float RandomCoord(uint32_t& seed, int32_t size, int32_t margin)
+    {
+        const uint32_t fraction = 64;
+        uint32_t range = static_cast<uint32_t>(size - margin * 2) * fraction;
+        return margin + static_cast<float>(NextRandom(seed) % range) / fraction;
+    }
+
+    template <class Rasterizer>
+    void AddPolygon(Rasterizer& ras, uint32_t seed, uint32_t numVertices, int32_t margin)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, WIDTH, margin);
+            float y = RandomCoord(seed, HEIGHT, margin);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    template <class Rasterizer>
+    void AddStar(Rasterizer& ras, float centerX, float centerY, float radius, uint32_t points)
+    {
+        for (uint32_t i = 0; i < points * 2; i++) {
+            float angle = PI * i / points;
+            float r = (i & 1) ? radius * 0.4f : radius; // 0.4: the inner radius
+            float x = centerX + r * cosf(angle);
+            float y = centerY + r * sinf(angle);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    /*
+     * The fixed paths of the tests: a rectangle on the pixel centers, a rectangle with a hole, stars,
+     * and random polygons crossing themselves, where the filling rules differ.
+     */
+    template <class Rasterizer>
+    void AddTestPath(Rasterizer& ras, uint32_t index)
+    {
+        switch (index) {
+            case 0: // 0: the edges through the centers of the pixels
+                ras.MoveToByfloat(10.5f, 20.5f);
+                ras.LineToByfloat(200.5f, 20.5f);
+                ras.LineToByfloat(200.5f, 230.5f);
+                ras.LineToByfloat(10.5f, 230.5f);
+                ras.ClosePolygon();
+                break;
+            case 1: // 1: a rectangle with a hole of the opposite direction
+                ras.MoveToByfloat(20.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 236.0f);
+                ras.LineToByfloat(20.0f, 236.0f);
+                ras.ClosePolygon();
+                ras.MoveToByfloat(60.5f, 60.5f);
+                ras.LineToByfloat(60.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 60.5f);
+                ras.ClosePolygon();
+                break;
+            case 2: // 2: stars
+                AddStar(ras, 128.0f, 128.0f, 120.0f, 7); // 128: center, 120: radius, 7: points
+                AddStar(ras, 64.3f, 70.7f, 50.0f, 23);   // 64.3, 70.7: center, 50: radius, 23: points
+                break;
+            case 3: // 3: a few vertices
+                AddPolygon(ras, 11, 7, 1); // 11: seed, 7: vertices, 1: margin
+                break;
+            default:
+                AddPolygon(ras, 12, 150, 1); // 12: seed, 150: vertices, 1: margin
+                break;
+        }
+    }
+
+    // The edges of a path with sub pixels, to test the pixel centers against them one by one
+    class CenterPath {
+    public:
+        void MoveToByfloat(float x, float y)
+        {
+            ClosePolygon();
+            startX_ = lastX_ = RasterDepictInt::UpScale(x);
+            startY_ = lastY_ = RasterDepictInt::UpScale(y);
+        }
+
+        void LineToByfloat(float x, float y)
+        {
+            AddEdge(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
+        }
+
+        void ClosePolygon()
+        {
+            AddEdge(startX_, startY_);
+        }
+
+        /*
+         * The winding number of the center of a pixel: an edge counts when the center is on its row range,
+         * top included and bottom excluded, and on its right or on it.
+         */
+        int32_t GetWindingNumber(int32_t x, int32_t y) const
+        {
+            const int64_t halfPixel = POLY_SUBPIXEL_SCALE >> 1;
+            int64_t centerX = (static_cast<int64_t>(x) << POLY_SUBPIXEL_SHIFT) + halfPixel;
+            int64_t centerY = (static_cast<int64_t>(y) << POLY_SUBPIXEL_SHIFT) + halfPixel;
+            int32_t winding = 0;
+            for (uint32_t i = 0; i < numEdges_; i++) {
+                const int64_t* edge = edges_[i];
+                int64_t dy = edge[3] - edge[1]; // 3: y2, 1: y1
+                int64_t top = (dy > 0) ? edge[1] : edge[3]; // 1: y1, 3: y2
+                int64_t bottom = (dy > 0) ? edge[3] : edge[1]; // 1: y1, 3: y2
+                if (dy == 0 || centerY < top || centerY >= bottom) {
+                    continue;
+                }
+                // centerX - crossing >= 0, with the crossing at x1 + (centerY - y1) * dx / dy
+                int64_t side = (centerX - edge[0]) * dy - (centerY - edge[1]) * (edge[2] - edge[0]); // 2: x2
+                if ((dy > 0) ? (side >= 0) : (side <= 0)) {
+                    winding += (dy > 0) ? 1 : -1;
+                }
+            }
+            return winding;
+        }
+
+        /*
+         * Whether the center of a pixel is within a sub pixel of an edge on its row, where the lines
+         * cut at rounded points by the clipper may pass on either side of it.
+         */
+        bool IsNearEdge(int32_t x, int32_t y) const
+        {
+            const int64_t halfPixel = POLY_SUBPIXEL_SCALE >> 1;
+            int64_t centerX = (static_cast<int64_t>(x) << POLY_SUBPIXEL_SHIFT) + halfPixel;
+            int64_t centerY = (static_cast<int64_t>(y) << POLY_SUBPIXEL_SHIFT) + halfPixel;
+            for (uint32_t i = 0; i < numEdges_; i++) {
+                const int64_t* edge = edges_[i];
+                int64_t dy = edge[3] - edge[1]; // 3: y2, 1: y1
+                int64_t top = (dy > 0) ? edge[1] : edge[3]; // 1: y1, 3: y2
+                int64_t bottom = (dy > 0) ? edge[3] : edge[1]; // 1: y1, 3: y2
+                if (dy == 0 || centerY < top || centerY > bottom) {
+                    continue;
+                }
+                // |centerX - crossing| <= 1, with the crossing at x1 + (centerY - y1) * dx / dy
+                int64_t side = (centerX - edge[0]) * dy - (centerY - edge[1]) * (edge[2] - edge[0]); // 2: x2
+                if (side <= (dy > 0 ? dy : -dy) && side >= (dy > 0 ? -dy : dy)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        void AddEdge(int32_t x, int32_t y)
+        {
+            if ((x != lastX_ || y != lastY_) && numEdges_ < MAX_EDGES) {
+                int64_t* edge = edges_[numEdges_++];
+                edge[0] = lastX_;
+                edge[1] = lastY_;
+                edge[2] = x; // 2: x2
+                edge[3] = y; // 3: y2
+            }
+            lastX_ = x;
+            lastY_ = y;
+        }
+
+        int64_t edges_[MAX_EDGES][4]; // 4: x1, y1, x2, y2
+        uint32_t numEdges_ = 0;
+        int32_t startX_ = 0;
+        int32_t startY_ = 0;
+        int32_t lastX_ = 0;
+        int32_t lastY_ = 0;
+    };
+
+    /*
+     * Sweep the rasterizer into an image of WIDTH x HEIGHT alphas.
+     * @return The number of scanlines, or -1 for a scanline out of the image or out of order.
+     */
+    template <class Rasterizer, class Scanline>
+    int32_t SweepToImage(Rasterizer& ras, Scanline& sl, uint8_t* image)
+    {
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        if (!ras.RewindScanlines()) {
+            return 0;
+        }
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        int32_t lastY = INT32_MIN;
+        while (ras.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            if (y <= lastY || y < 0 || y >= HEIGHT) {
+                return -1;
+            }
+            lastY = y;
+            numScanlines++;
+            typename Scanline::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                int32_t length = span->spanLength;
+                bool solid = length < 0;
+                length = solid ? -length : length;
+                if (span->x < 0 || span->x + length > WIDTH) {
+                    return -1;
+                }
+                for (int32_t k = 0; k < length; k++) {
+                    image[y * WIDTH + span->x + k] = solid ? *span->covers : span->covers[k];
+                }
+            }
+        }
+        return numScanlines;
+    }
+
+    template <class Rasterizer>
+    int32_t SweepToImage(Rasterizer& ras, uint8_t* image)
+    {
+        GeometryScanline sl;
+        return SweepToImage(ras, sl, image);
+    }
+
+    // Full cover on the pixels whose centers are inside the path and the clip box
+    void CentersToImage(const CenterPath& path, FillingRule rule, const int32_t* clip, uint8_t* image)
+    {
+        for (int32_t y = 0; y < HEIGHT; y++) {
+            for (int32_t x = 0; x < WIDTH; x++) {
+                int32_t winding = path.GetWindingNumber(x, y);
+                bool inside = (rule == FILL_EVEN_ODD) ? ((winding & 1) != 0) : (winding != 0);
+                // 0, 1, 2, 3: the left, top, right and bottom of the clip box, in pixels
+                inside = inside && (clip == nullptr || (x >= clip[0] && x < clip[2] && y >= clip[1] && y < clip[3]));
+                image[y * WIDTH + x] = inside ? FULL_COVER : 0;
+            }
+        }
+    }
+
+    uint32_t CountDiffs(const uint8_t* image, const uint8_t* expect)
+    {
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (image[i] != expect[i]) ? 1 : 0;
+        }
+        return diffs;
+    }
+}
+
+class RasterizerScanlineBinaryTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerScanlineBinary_001
+ * @tc.desc: Verify the binary spans cover exactly the pixels whose centers are inside, with both filling rules.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineBinaryTest, RasterizerScanlineBinary_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    RasterizerScanlineBinary ras;
+    for (FillingRule rule : rules) {
+        ras.SetFillingRule(rule);
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            CenterPath centers;
+            AddTestPath(centers, path);
+            CentersToImage(centers, rule, nullptr, expect);
+            AddTestPath(ras, path);
+            EXPECT_GT(SweepToImage(ras, image), 0) << "path " << path;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path << " rule " << rule;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineBinary_002
+ * @tc.desc: Verify the binary spans of clipped paths cover the pixels whose centers are inside the clip box too.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineBinaryTest, RasterizerScanlineBinary_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const int32_t clip[] = {30, 70, 200, 180}; // 30, 70, 200, 180: the clip box
+    RasterizerScanlineBinary ras;
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        CenterPath centers;
+        AddTestPath(centers, path);
+        CentersToImage(centers, FILL_NON_ZERO, clip, expect);
+        // 0, 1, 2, 3: the left, top, right and bottom of the clip box
+        ras.ClipBox(static_cast<float>(clip[0]), static_cast<float>(clip[1]),
+                    static_cast<float>(clip[2]), static_cast<float>(clip[3]));
+        AddTestPath(ras, path);
+        EXPECT_GT(SweepToImage(ras, image), 0) << "path " << path;
+        uint32_t diffs = 0;
+        for (int32_t y = 0; y < HEIGHT; y++) {
+            for (int32_t x = 0; x < WIDTH; x++) {
+                bool differ = image[y * WIDTH + x] != expect[y * WIDTH + x];
+                diffs += (differ && !centers.IsNearEdge(x, y)) ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(diffs, 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineBinary_003
+ * @tc.desc: Verify the binary spans cover the pixels fully covered by the anti-aliased rasterizer,
+ *           and none of the pixels it leaves empty.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineBinaryTest, RasterizerScanlineBinary_003, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias antialias;
+    RasterizerScanlineBinary binary;
+    // The random polygon of the last path has slivers thinner than one alpha step, on either side of centers
+    for (uint32_t path = 0; path < NUM_PATHS - 1; path++) {
+        AddTestPath(antialias, path);
+        AddTestPath(binary, path);
+        SweepToImage(antialias, expect);
+        SweepToImage(binary, image);
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (expect[i] == FULL_COVER && image[i] != FULL_COVER) ? 1 : 0;
+            diffs += (expect[i] == 0 && image[i] != 0) ? 1 : 0;
+        }
+        EXPECT_EQ(diffs, 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineBinary_004
+ * @tc.desc: Verify the packed scanlines hold only solid spans, covering the pixels of the unpacked scanlines.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineBinaryTest, RasterizerScanlineBinary_004, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineBinary ras;
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        AddTestPath(ras, path);
+        int32_t numScanlines = SweepToImage(ras, expect);
+        GeometryScanlinePacked sl;
+        EXPECT_EQ(SweepToImage(ras, sl, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+
+        ASSERT_TRUE(ras.RewindScanlines());
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        while (ras.SweepScanline(sl)) {
+            GeometryScanlinePacked::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                ASSERT_LT(span->spanLength, 0);
+                ASSERT_EQ(*span->covers, FULL_COVER);
+            }
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_clip.h"
+
+#include <climits>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t SMALL_RANGE = 24;
+
+    // a * b / c rounded to the nearest, halves away from zero
+    int64_t ReferenceMultDiv(int64_t a, int64_t b, int64_t c)
+    {
+        int64_t product = a * b;
+        bool negative = (product < 0) != (c < 0);
+        uint64_t absProduct = (product < 0) ? static_cast<uint64_t>(-product) : static_cast<uint64_t>(product);
+        uint64_t absDivisor = (c < 0) ? static_cast<uint64_t>(-c) : static_cast<uint64_t>(c);
+        uint64_t quotient = absProduct / absDivisor;
+        if (2 * (absProduct % absDivisor) >= absDivisor) { // 2: compare the remainder to half the divisor
+            quotient++;
+        }
+        return negative ? -static_cast<int64_t>(quotient) : static_cast<int64_t>(quotient);
+    }
+}
+
+class RasterizerScanlineClipTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: IntegerMultDiv_001
+ * @tc.desc: Verify IntegerMultDiv rounds to the nearest for every sign combination.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_001, TestSize.Level0)
+{
+    // 6 * 7 / 4 = 10.5
+    EXPECT_EQ(IntegerMultDiv(6, 7, 4), 11);
+    EXPECT_EQ(IntegerMultDiv(-6, 7, 4), -11);
+    EXPECT_EQ(IntegerMultDiv(6, -7, 4), -11);
+    EXPECT_EQ(IntegerMultDiv(6, 7, -4), -11);
+    EXPECT_EQ(IntegerMultDiv(-6, -7, 4), 11);
+    EXPECT_EQ(IntegerMultDiv(-6, 7, -4), 11);
+    EXPECT_EQ(IntegerMultDiv(6, -7, -4), 11);
+    EXPECT_EQ(IntegerMultDiv(-6, -7, -4), -11);
+
+    // 7 / 4 = 1.75 and 5 / 4 = 1.25
+    EXPECT_EQ(IntegerMultDiv(7, 1, 4), 2);
+    EXPECT_EQ(IntegerMultDiv(5, 1, 4), 1);
+    EXPECT_EQ(IntegerMultDiv(-7, 1, 4), -2);
+    EXPECT_EQ(IntegerMultDiv(-5, 1, 4), -1);
+    EXPECT_EQ(IntegerMultDiv(7, 1, -4), -2);
+    EXPECT_EQ(IntegerMultDiv(5, 1, -4), -1);
+}
+
+/**
+ * @tc.name: IntegerMultDiv_002
+ * @tc.desc: Verify IntegerMultDiv rounds exact halves away from zero, as MATH_ROUND32.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_002, TestSize.Level0)
+{
+    EXPECT_EQ(IntegerMultDiv(1, 1, 2), 1);
+    EXPECT_EQ(IntegerMultDiv(-1, 1, 2), -1);
+    EXPECT_EQ(IntegerMultDiv(1, 1, -2), -1);
+    EXPECT_EQ(IntegerMultDiv(-1, -1, -2), -1);
+    EXPECT_EQ(IntegerMultDiv(3, 1, 2), 2);
+    EXPECT_EQ(IntegerMultDiv(-3, 1, 2), -2);
+    EXPECT_EQ(IntegerMultDiv(3, 3, 2), 5);
+    EXPECT_EQ(IntegerMultDiv(3, -3, 2), -5);
+    EXPECT_EQ(IntegerMultDiv(3, 3, 2), MATH_ROUND32(3.0f * 3.0f / 2.0f));
+    EXPECT_EQ(IntegerMultDiv(-3, 3, 2), MATH_ROUND32(-3.0f * 3.0f / 2.0f));
+}
+
+/**
+ * @tc.name: IntegerMultDiv_003
+ * @tc.desc: Verify IntegerMultDiv returns 0 for a zero divisor or product.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_003, TestSize.Level0)
+{
+    EXPECT_EQ(IntegerMultDiv(5, 7, 0), 0);
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, INT32_MAX, 0), 0);
+    EXPECT_EQ(IntegerMultDiv(0, 7, 3), 0);
+    EXPECT_EQ(IntegerMultDiv(5, 0, -3), 0);
+}
+
+/**
+ * @tc.name: IntegerMultDiv_004
+ * @tc.desc: Verify IntegerMultDiv near the INT32 limits, where the product needs 64 bits.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_004, TestSize.Level0)
+{
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, INT32_MAX, INT32_MAX), INT32_MAX);
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN, INT32_MIN, INT32_MIN), INT32_MIN);
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, INT32_MIN, INT32_MAX), INT32_MIN);
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN, INT32_MAX, INT32_MIN), INT32_MAX);
+    // (2^31 - 1)^2 / -2^31 = -(2^31 - 2 + 2^-31)
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, INT32_MAX, INT32_MIN), INT32_MIN + 2); // 2: -(2^31 - 2)
+    // Exact halves at the limits
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, 1, 2), INT32_MAX / 2 + 1);
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN + 1, 1, 2), INT32_MIN / 2);
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN, 1, 2), INT32_MIN / 2);
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN, -1, 2), -(INT32_MIN / 2));
+    // A product far beyond 32 bits, divided back into range
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX, 3, 4), ReferenceMultDiv(INT32_MAX, 3, 4));
+    EXPECT_EQ(IntegerMultDiv(INT32_MIN, 3, -4), ReferenceMultDiv(INT32_MIN, 3, -4));
+    EXPECT_EQ(IntegerMultDiv(INT32_MAX - 7, INT32_MIN + 9, INT32_MAX),
+              ReferenceMultDiv(INT32_MAX - 7, INT32_MIN + 9, INT32_MAX));
+}
+
+/**
+ * @tc.name: IntegerMultDiv_005
+ * @tc.desc: Verify IntegerMultDiv against the exact rounding for every small operand.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_005, TestSize.Level0)
+{
+    for (int32_t a = -SMALL_RANGE; a <= SMALL_RANGE; a++) {
+        for (int32_t b = -SMALL_RANGE; b <= SMALL_RANGE; b++) {
+            for (int32_t c = -SMALL_RANGE; c <= SMALL_RANGE; c++) {
+                if (c == 0) {
+                    continue;
+                }
+                ASSERT_EQ(IntegerMultDiv(a, b, c), ReferenceMultDiv(a, b, c)) << a << " " << b << " " << c;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: IntegerMultDiv_006
+ * @tc.desc: Verify RasterDepictInt::MultDiv of the configured build is within one of IntegerMultDiv
+ *           on the subpixel coordinates of the clip box.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineClipTest, IntegerMultDiv_006, TestSize.Level0)
+{
+    const int32_t range = 4096 << POLY_SUBPIXEL_SHIFT; // 4096: pixels
+    const int32_t step = 997; // 997: a prime step through the range
+    for (int32_t a = -range; a <= range; a += step * 61) { // 61: fewer dividends than divisors
+        for (int32_t c = -range; c <= range; c += step) {
+            int32_t b = c / 3; // 3: a divisor above the dividend, as for an edge crossing the clip box
+            int32_t diff = RasterDepictInt::MultDiv(a, b, c) - IntegerMultDiv(a, b, c);
+            ASSERT_LE(abs(diff), 1) << a << " " << b << " " << c;
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_compound.h"
+#include "securec.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t WIDTH = 256;
+    const int32_t HEIGHT = 256;
+    const uint32_t NUM_PATHS = 5;
+    // The style ids of the paths are sparse
+    const uint32_t STYLE_STEP = 3;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    const float PI = 3.14159265f;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // A point in [margin, size - margin) with a fraction of 1 / 64 pixel
+    float RandomCoord(uint32_t& seed, int32_t size, int32_t margin)
+    {
+        const uint32_t fraction = 64;
+        uint32_t range = static_cast<uint32_t>(size - margin * 2) * fraction;
+        return margin + static_cast<float>(NextRandom(seed) % range) / fraction;
+    }
+
+    template <class Rasterizer>
+    void AddPolygon(Rasterizer& ras, uint32_t seed, uint32_t numVertices, int32_t margin)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, WIDTH, margin);
+            float y = RandomCoord(seed, HEIGHT, margin);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    template <class Rasterizer>
+    void AddStar(Rasterizer& ras, float centerX, float centerY, float radius, uint32_t points)
+    {
+        for (uint32_t i = 0; i < points * 2; i++) {
+            float angle = PI * i / points;
+            float r = (i & 1) ? radius * 0.4f : radius; // 0.4: the inner radius
+            float x = centerX + r * cosf(angle);
+            float y = centerY + r * sinf(angle);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    // The fixed paths of the tests: a triangle, a rectangle with a hole, stars, and random polygons
+    template <class Rasterizer>
+    void AddTestPath(Rasterizer& ras, uint32_t index)
+    {
+        switch (index) {
+            case 0: // 0: a triangle
+                ras.MoveToByfloat(10.5f, 20.25f);
+                ras.LineToByfloat(200.75f, 60.5f);
+                ras.LineToByfloat(80.25f, 230.75f);
+                ras.ClosePolygon();
+                break;
+            case 1: // 1: a rectangle with a hole of the opposite direction
+                ras.MoveToByfloat(20.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 20.0f);
+                ras.LineToByfloat(236.0f, 236.0f);
+                ras.LineToByfloat(20.0f, 236.0f);
+                ras.ClosePolygon();
+                ras.MoveToByfloat(60.5f, 60.5f);
+                ras.LineToByfloat(60.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 190.5f);
+                ras.LineToByfloat(190.5f, 60.5f);
+                ras.ClosePolygon();
+                break;
+            case 2: // 2: stars
+                AddStar(ras, 128.0f, 128.0f, 120.0f, 7); // 128: center, 120: radius, 7: points
+                AddStar(ras, 64.3f, 70.7f, 50.0f, 23);   // 64.3, 70.7: center, 50: radius, 23: points
+                break;
+            case 3: // 3: a few vertices
+                AddPolygon(ras, 11, 7, 1); // 11: seed, 7: vertices, 1: margin
+                break;
+            default:
+                AddPolygon(ras, 12, 150, 1); // 12: seed, 150: vertices, 1: margin
+                break;
+        }
+    }
+
+    /*
+     * Sweep a single rasterizer into an image of WIDTH x HEIGHT alphas.
+     * @return The number of scanlines.
+     */
+    int32_t SweepToImage(RasterizerScanlineAntialias& ras, uint8_t* image)
+    {
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        if (!ras.RewindScanlines()) {
+            return 0;
+        }
+        GeometryScanline sl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        while (ras.SweepScanline(sl)) {
+            numScanlines++;
+            GeometryScanline::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                for (int32_t k = 0; k < span->spanLength; k++) {
+                    image[sl.GetYLevel() * WIDTH + span->x + k] = span->covers[k];
+                }
+            }
+        }
+        return numScanlines;
+    }
+
+    /*
+     * Sweep every style of the compound rasterizer into the image of its path, path = style / STYLE_STEP.
+     * @return The number of scanlines of all styles, or -1 for rows or styles out of order or out of the image.
+     */
+    int32_t SweepStylesToImages(RasterizerScanlineCompound& ras, uint8_t images[][WIDTH * HEIGHT])
+    {
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            if (memset_s(images[path], WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+                return -1;
+            }
+        }
+        if (!ras.RewindScanlines()) {
+            return 0;
+        }
+        GeometryScanline sl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        int32_t lastY = INT32_MIN;
+        uint32_t numStyles;
+        while ((numStyles = ras.SweepStyles()) != 0) {
+            int32_t y = ras.GetScanY();
+            if (y <= lastY || y < 0 || y >= HEIGHT) {
+                return -1;
+            }
+            lastY = y;
+            for (uint32_t index = 0; index < numStyles; index++) {
+                uint32_t style = ras.GetStyle(index);
+                uint32_t path = style / STYLE_STEP;
+                if ((index > 0 && style <= ras.GetStyle(index - 1)) || path >= NUM_PATHS) {
+                    return -1;
+                }
+                if (!ras.SweepScanline(sl, index)) {
+                    continue;
+                }
+                numScanlines++;
+                GeometryScanline::ConstIterator span = sl.Begin();
+                for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                    for (int32_t k = 0; k < span->spanLength; k++) {
+                        images[path][y * WIDTH + span->x + k] = span->covers[k];
+                    }
+                }
+            }
+        }
+        return numScanlines;
+    }
+
+    uint32_t CountDiffs(const uint8_t* image, const uint8_t* expect)
+    {
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (image[i] != expect[i]) ? 1 : 0;
+        }
+        return diffs;
+    }
+
+    /*
+     * Rasterize the paths one by one with a single rasterizer.
+     * @return The number of scanlines of all paths.
+     */
+    int32_t SweepPathsToImages(RasterizerScanlineAntialias& ras, uint8_t expect[][WIDTH * HEIGHT])
+    {
+        int32_t numScanlines = 0;
+        for (uint32_t path = 0; path < NUM_PATHS; path++) {
+            AddTestPath(ras, path);
+            numScanlines += SweepToImage(ras, expect[path]);
+        }
+        return numScanlines;
+    }
+}
+
+class RasterizerScanlineCompoundTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerScanlineCompound_001
+ * @tc.desc: Verify every style sweeps the scanlines of its path rasterized alone, rows and styles in order.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineCompoundTest, RasterizerScanlineCompound_001, TestSize.Level0)
+{
+    static uint8_t expect[NUM_PATHS][WIDTH * HEIGHT];
+    static uint8_t images[NUM_PATHS][WIDTH * HEIGHT];
+    RasterizerScanlineAntialias single;
+    int32_t numScanlines = SweepPathsToImages(single, expect);
+
+    RasterizerScanlineCompound compound;
+    // The styles are added from the last, the paint order is still by style id
+    for (uint32_t path = NUM_PATHS; path > 0; path--) {
+        compound.SetStyle((path - 1) * STYLE_STEP);
+        AddTestPath(compound, path - 1);
+    }
+    EXPECT_EQ(SweepStylesToImages(compound, images), numScanlines);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        EXPECT_EQ(CountDiffs(images[path], expect[path]), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineCompound_002
+ * @tc.desc: Verify the styles of clipped paths, and of the next paths after a sweep, match the single rasterizer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineCompoundTest, RasterizerScanlineCompound_002, TestSize.Level0)
+{
+    static uint8_t expect[NUM_PATHS][WIDTH * HEIGHT];
+    static uint8_t images[NUM_PATHS][WIDTH * HEIGHT];
+    RasterizerScanlineAntialias single;
+    RasterizerScanlineCompound compound;
+    single.ClipBox(30.0f, 70.0f, 200.0f, 180.0f);   // 30, 70, 200, 180: the clip box
+    compound.ClipBox(30.0f, 70.0f, 200.0f, 180.0f); // 30, 70, 200, 180: the clip box
+    int32_t numScanlines = SweepPathsToImages(single, expect);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        compound.SetStyle(path * STYLE_STEP);
+        AddTestPath(compound, path);
+    }
+    EXPECT_EQ(SweepStylesToImages(compound, images), numScanlines);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        EXPECT_EQ(CountDiffs(images[path], expect[path]), 0u) << "path " << path;
+    }
+
+    // The next paths reset the styles swept before, and a style can take a path again
+    single.ResetClipping();
+    compound.ResetClipping();
+    numScanlines = SweepPathsToImages(single, expect);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        compound.SetStyle(path * STYLE_STEP);
+        AddTestPath(compound, path);
+    }
+    EXPECT_EQ(SweepStylesToImages(compound, images), numScanlines);
+    EXPECT_EQ(SweepStylesToImages(compound, images), numScanlines);
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        EXPECT_EQ(CountDiffs(images[path], expect[path]), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineCompound_003
+ * @tc.desc: Verify a compound rasterizer without paths, or with paths out of the clip box, has no rows.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineCompoundTest, RasterizerScanlineCompound_003, TestSize.Level0)
+{
+    RasterizerScanlineCompound compound;
+    EXPECT_FALSE(compound.RewindScanlines());
+    EXPECT_EQ(compound.SweepStyles(), 0u);
+
+    compound.ClipBox(300.0f, 300.0f, 400.0f, 400.0f); // 300, 400: a clip box out of the paths
+    compound.SetStyle(1);
+    AddTestPath(compound, 0);
+    compound.SetStyle(0);
+    AddTestPath(compound, 2); // 2: stars
+    EXPECT_FALSE(compound.RewindScanlines());
+    EXPECT_EQ(compound.SweepStyles(), 0u);
+}
+
+/**
+ * @tc.name: RasterizerScanlineCompound_004
+ * @tc.desc: Verify the paths of style ids at or above MAX_STYLE_ID are dropped, and the last id below it is swept.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineCompoundTest, RasterizerScanlineCompound_004, TestSize.Level0)
+{
+    RasterizerScanlineCompound compound;
+    compound.SetStyle(RasterizerScanlineCompound::MAX_STYLE_ID);
+    AddTestPath(compound, 0);
+    compound.SetStyle(UINT32_MAX);
+    AddTestPath(compound, 1);
+    EXPECT_FALSE(compound.RewindScanlines());
+    EXPECT_EQ(compound.SweepStyles(), 0u);
+
+    compound.SetStyle(RasterizerScanlineCompound::MAX_STYLE_ID - 1);
+    AddTestPath(compound, 0);
+    compound.SetStyle(UINT32_MAX - 1);
+    AddTestPath(compound, 1);
+    ASSERT_TRUE(compound.RewindScanlines());
+    uint32_t numRows = 0;
+    while (compound.SweepStyles() != 0) {
+        ASSERT_EQ(compound.GetStyle(0), static_cast<uint32_t>(RasterizerScanlineCompound::MAX_STYLE_ID - 1));
+        numRows++;
+    }
+    EXPECT_GT(numRows, 0u);
+}
+} // namespace OHOS
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_parallel.h"
+#include "securec.h"
+
+#include <climits>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t WIDTH = 512;
+    const int32_t HEIGHT = 512;
+    const uint32_t NUM_PATHS = 4;
+    const uint32_t RANDOM_MULTIPLIER = 1103515245;
+    const uint32_t RANDOM_INCREMENT = 12345;
+    const float PI = 3.14159265f;
+
+    uint32_t NextRandom(uint32_t& seed)
+    {
+        seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+        return seed >> 8; // 8: drop the low bits of the congruential generator
+    }
+
+    // A point in [margin, size - margin) with a fraction of 1 / 64 pixel
+    float RandomCoord(uint32_t& seed, int32_t size, int32_t margin)
+    {
+        const uint32_t fraction = 64;
+        uint32_t range = static_cast<uint32_t>(size - margin * 2) * fraction;
+        return margin + static_cast<float>(NextRandom(seed) % range) / fraction;
+    }
+
+    template <class Rasterizer>
+    void AddPolygon(Rasterizer& ras, uint32_t seed, uint32_t numVertices, int32_t margin)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, WIDTH, margin);
+            float y = RandomCoord(seed, HEIGHT, margin);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    template <class Rasterizer>
+    void AddStar(Rasterizer& ras, float centerX, float centerY, float radius, uint32_t points)
+    {
+        for (uint32_t i = 0; i < points * 2; i++) {
+            float angle = PI * i / points;
+            float r = (i & 1) ? radius * 0.4f : radius; // 0.4: the inner radius
+            float x = centerX + r * cosf(angle);
+            float y = centerY + r * sinf(angle);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    // The fixed paths of the tests: a triangle, a star crossing the bands, and random polygons
+    template <class Rasterizer>
+    void AddTestPath(Rasterizer& ras, uint32_t index)
+    {
+        switch (index) {
+            case 0: // 0: a triangle
+                ras.MoveToByfloat(10.5f, 20.25f);
+                ras.LineToByfloat(500.75f, 160.5f);
+                ras.LineToByfloat(80.25f, 490.75f);
+                ras.ClosePolygon();
+                break;
+            case 1: // 1: a star
+                AddStar(ras, 256.3f, 250.7f, 240.0f, 9); // 256.3, 250.7: center, 240: radius, 9: points
+                break;
+            case 2: // 2: a few vertices
+                AddPolygon(ras, 21, 9, 1); // 21: seed, 9: vertices, 1: margin
+                break;
+            default:
+                AddPolygon(ras, 22, 40, 1); // 22: seed, 40: vertices within the cell block limit, 1: margin
+                break;
+        }
+    }
+
+    /*
+     * Sweep the rasterizer into an image of WIDTH x HEIGHT alphas.
+     * @return The number of scanlines, or -1 for a scanline out of the image or out of order.
+     */
+    template <class Rasterizer>
+    int32_t SweepToImage(Rasterizer& ras, uint8_t* image)
+    {
+        if (memset_s(image, WIDTH * HEIGHT, 0, WIDTH * HEIGHT) != EOK) {
+            return -1;
+        }
+        if (!ras.RewindScanlines()) {
+            return 0;
+        }
+        GeometryScanline sl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        int32_t numScanlines = 0;
+        int32_t lastY = INT32_MIN;
+        while (ras.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            if (y <= lastY || y < 0 || y >= HEIGHT) {
+                return -1;
+            }
+            lastY = y;
+            numScanlines++;
+            GeometryScanline::ConstIterator span = sl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++) {
+                if (span->x < 0 || span->x + span->spanLength > WIDTH) {
+                    return -1;
+                }
+                for (int32_t k = 0; k < span->spanLength; k++) {
+                    image[y * WIDTH + span->x + k] = span->covers[k];
+                }
+            }
+        }
+        return numScanlines;
+    }
+
+    // A random polygon over width x height pixels, past the image of the other paths
+    template <class Rasterizer>
+    void AddLargePolygon(Rasterizer& ras, uint32_t seed, uint32_t numVertices, int32_t width, int32_t height)
+    {
+        for (uint32_t i = 0; i < numVertices; i++) {
+            float x = RandomCoord(seed, width, 0);
+            float y = RandomCoord(seed, height, 0);
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+        ras.ClosePolygon();
+    }
+
+    /*
+     * Whether two rasterizers sweep the same spans with the same covers, row after row.
+     * @return The sum of the covers, or -1 for any difference.
+     */
+    template <class Rasterizer, class Other>
+    int64_t SameSweeps(Rasterizer& ras, Other& other)
+    {
+        bool rewound = ras.RewindScanlines();
+        if (rewound != other.RewindScanlines()) {
+            return -1;
+        }
+        if (!rewound) {
+            return 0;
+        }
+        GeometryScanline sl;
+        GeometryScanline otherSl;
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        otherSl.Reset(other.GetMinX(), other.GetMaxX());
+        int64_t sum = 0;
+        while (ras.SweepScanline(sl)) {
+            if (!other.SweepScanline(otherSl) || sl.GetYLevel() != otherSl.GetYLevel() ||
+                sl.NumSpans() != otherSl.NumSpans()) {
+                return -1;
+            }
+            GeometryScanline::ConstIterator span = sl.Begin();
+            GeometryScanline::ConstIterator otherSpan = otherSl.Begin();
+            for (uint32_t i = sl.NumSpans(); i > 0; i--, span++, otherSpan++) {
+                if (span->x != otherSpan->x || span->spanLength != otherSpan->spanLength) {
+                    return -1;
+                }
+                for (int32_t k = 0; k < span->spanLength; k++) {
+                    if (span->covers[k] != otherSpan->covers[k]) {
+                        return -1;
+                    }
+                    sum += span->covers[k];
+                }
+            }
+        }
+        return other.SweepScanline(otherSl) ? -1 : sum;
+    }
+
+    uint32_t CountDiffs(const uint8_t* image, const uint8_t* expect)
+    {
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (image[i] != expect[i]) ? 1 : 0;
+        }
+        return diffs;
+    }
+}
+
+class RasterizerScanlineParallelTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerScanlineParallel_001
+ * @tc.desc: Verify the bands sweep the same scanlines as the single threaded rasterizer, for any number of bands.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_001, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    const uint32_t bands[] = {1, 2, 3, 4, RasterizerScanlineParallel::MAX_BANDS};
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        RasterizerScanlineAntialias single;
+        AddTestPath(single, path);
+        int32_t numScanlines = SweepToImage(single, expect);
+        EXPECT_GT(numScanlines, 0);
+        for (uint32_t numBands : bands) {
+            RasterizerScanlineParallel parallel;
+            parallel.SetMaxBands(numBands);
+            AddTestPath(parallel, path);
+            EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "path " << path << " bands " << numBands;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path << " bands " << numBands;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallel_002
+ * @tc.desc: Verify the bands of a clipped path match the single threaded rasterizer.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_002, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias single;
+    RasterizerScanlineParallel parallel;
+    parallel.SetMaxBands(4); // 4: bands
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        single.ClipBox(30.0f, 70.0f, 400.0f, 450.0f);   // 30, 70, 400, 450: the clip box
+        parallel.ClipBox(30.0f, 70.0f, 400.0f, 450.0f); // 30, 70, 400, 450: the clip box
+        AddTestPath(single, path);
+        AddTestPath(parallel, path);
+        int32_t numScanlines = SweepToImage(single, expect);
+        EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallel_003
+ * @tc.desc: Verify one parallel rasterizer sweeps a path again after a rewind, and then other paths.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_003, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineParallel parallel;
+    parallel.SetMaxBands(3); // 3: bands
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        RasterizerScanlineAntialias single;
+        AddTestPath(single, path);
+        int32_t numScanlines = SweepToImage(single, expect);
+
+        AddTestPath(parallel, path);
+        EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+        EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "path " << path;
+        EXPECT_EQ(CountDiffs(image, expect), 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallel_004
+ * @tc.desc: Verify the gamma curve of the parallel rasterizer applies to every band.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_004, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias table;
+    table.Gamma(GammaPower(0.5f)); // 0.5: gamma
+    RasterizerScanlineParallel linear;
+    linear.SetMaxBands(4); // 4: bands
+    RasterizerScanlineParallel parallel;
+    parallel.SetMaxBands(4); // 4: bands
+    parallel.Gamma(GammaPower(0.5f)); // 0.5: gamma
+    for (uint32_t path = 0; path < NUM_PATHS; path++) {
+        AddTestPath(linear, path);
+        AddTestPath(parallel, path);
+        int32_t numScanlines = SweepToImage(linear, expect);
+        EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "path " << path;
+        uint32_t diffs = 0;
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            diffs += (image[i] != table.ApplyGamma(expect[i])) ? 1 : 0;
+        }
+        EXPECT_EQ(diffs, 0u) << "path " << path;
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallel_005
+ * @tc.desc: Verify the band workers serve rewind after rewind, and quit with the rasterizer,
+ *           also right after a rewind whose bands were never swept.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_005, TestSize.Level0)
+{
+    static uint8_t expect[WIDTH * HEIGHT];
+    static uint8_t image[WIDTH * HEIGHT];
+    RasterizerScanlineAntialias single;
+    AddTestPath(single, 1); // 1: the star crossing every band
+    int32_t numScanlines = SweepToImage(single, expect);
+    for (uint32_t cycle = 0; cycle < 20; cycle++) { // 20: rasterizers built and destroyed
+        RasterizerScanlineParallel parallel;
+        parallel.SetMaxBands(RasterizerScanlineParallel::MAX_BANDS);
+        AddTestPath(parallel, 1); // 1: the star crossing every band
+        for (uint32_t frame = 0; frame < 5; frame++) { // 5: rewinds of the same rasterizer
+            EXPECT_EQ(SweepToImage(parallel, image), numScanlines) << "cycle " << cycle << " frame " << frame;
+            EXPECT_EQ(CountDiffs(image, expect), 0u) << "cycle " << cycle << " frame " << frame;
+        }
+        EXPECT_TRUE(parallel.RewindScanlines());
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallel_006
+ * @tc.desc: Verify bands of a path over the cell budget of a band match the single threaded rasterizer,
+ *           under its budget and without any.
+ * @tc.type: FUNC
+ * @tc.require: AR000EEMQ9
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallel_006, TestSize.Level0)
+{
+    const int32_t size = 900; // 900: a square larger than the image of the other paths
+    const uint32_t numVertices = 2000; // 2000: vertices whose cells go over the default budget of a band
+    RasterizerScanlineAntialias whole;
+    whole.SetCellBudget(0);
+    RasterizerScanlineAntialias single;
+    // The default budget of a band, set to record the vertices as the bands do
+    single.SetCellBudget(1 << (RasterizerScanlineAntialias::AA_SHIFT + 2));
+    RasterizerScanlineParallel parallel;
+    parallel.SetMaxBands(4); // 4: bands
+    AddLargePolygon(whole, 4, numVertices, size, size); // 4: seed
+    AddLargePolygon(single, 4, numVertices, size, size); // 4: seed
+    AddLargePolygon(parallel, 4, numVertices, size, size); // 4: seed
+    int64_t coverage = SameSweeps(single, whole);
+    EXPECT_GT(coverage, 0);
+    EXPECT_TRUE(single.IsBanded());
+    EXPECT_EQ(SameSweeps(parallel, whole), coverage);
+}
+} // namespace OHOS